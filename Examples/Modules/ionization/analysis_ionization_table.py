@@ -0,0 +1,40 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script tests the tabulated ADK ionization rates
+# (<species>.ionization_table_points > 1), with the input file inputs_2d_rt:
+# as with the rates computed directly (see analysis_ionization.py), ~32% of the
+# Nitrogen ions must be N5+ after the laser went through the plasma, in
+# agreement with theory from Chen, JCP, 2013, figure 2. The table changes the
+# sequence of random numbers, so the particles are not compared with a checksum.
+
+import sys
+import yt
+yt.funcs.mylog.setLevel(0)
+
+# Open plotfile specified in command line, and get ion's ionization level.
+filename = sys.argv[1]
+ds = yt.load( filename )
+ad = ds.all_data()
+ilev = ad['ions', 'particle_ionization_level'].v
+
+# Fraction of Nitrogen ions that are N5+.
+N5_fraction = ilev[ilev == 5].size/float(ilev.size)
+
+print("Number of ions: " + str(ilev.size))
+print("Number of N5+ : " + str(ilev[ilev == 5].size))
+print("N5_fraction   : " + str(N5_fraction))
+
+# same tolerance as with the rates computed directly
+error_rel = abs(N5_fraction-0.32) / 0.32
+tolerance_rel = 0.07
+
+print("error_rel    : " + str(error_rel))
+print("tolerance_rel: " + str(tolerance_rel))
+
+assert( error_rel < tolerance_rel )
@@ -0,0 +1,66 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+## In this test, we check that the adaptive splitting reaches the target number of particles per
+## cell, keeps the split particles in the cell of the original particle and conserves the weight,
+## momentum, energy and center of charge of each cell, for the two split patterns.
+## The particles do not move, so the cell of each particle is the same before and after the
+## resampling.
+
+import yt
+import numpy as np
+import sys
+from scipy.constants import c, m_e
+
+fn_final = sys.argv[1]
+fn0 = fn_final[:-4] + '0000'
+
+ds0 = yt.load(fn0)
+ds = yt.load(fn_final)
+
+ad0 = ds0.all_data()
+ad = ds.all_data()
+
+ncells = 8
+ppc = 3
+# Each split particle is replaced by 4 particles in 2D, for both patterns, and the heaviest
+# particles are split until the cell has at least target_ppc = 8 particles
+expected_ppc = ppc + 2*3
+relative_tol = 1.e-12 # tolerance for machine precision errors
+
+def cell_sums(ad, species):
+    """Number of particles in each cell, and sum over each cell of the weight, of the three
+    components of the momentum, of the kinetic energy (momenta normalized by m_e*c) and of
+    the weighted position"""
+    x = ad[species, 'particle_position_x'].to_ndarray()
+    z = ad[species, 'particle_position_y'].to_ndarray()
+    w = ad[species, 'particle_weight'].to_ndarray()
+    u = [ad[species, 'particle_momentum_' + d].to_ndarray()/(m_e*c) for d in ['x', 'y', 'z']]
+    energy = np.sqrt(1. + u[0]**2 + u[1]**2 + u[2]**2) - 1.
+    cell = (np.floor(x).astype(int) + ncells*np.floor(z).astype(int))
+    counts = np.bincount(cell, minlength=ncells**2)
+    sums = [np.bincount(cell, weights=q, minlength=ncells**2)
+            for q in [w, w*u[0], w*u[1], w*u[2], w*energy, w*x, w*z]]
+    return counts, np.array(sums)
+
+for species in ['split_diagonal', 'split_axis']:
+    counts0, sums0 = cell_sums(ad0, species)
+    counts, sums = cell_sums(ad, species)
+
+    # A split particle that left its cell would change the number of particles in two cells
+    assert(np.all(counts0 == ppc))
+    assert(np.all(counts == expected_ppc))
+
+    for i, quantity in enumerate(['weight', 'x momentum', 'y momentum', 'z momentum', 'energy',
+                                  'x center of charge', 'z center of charge']):
+        # The scale of each quantity is its largest absolute value over the cells, so that
+        # the error on a component of the momentum that is close to 0 is not amplified
+        scale = np.max(np.abs(sums0[i]))
+        error = np.max(np.abs(sums[i] - sums0[i])) / scale
+        print(species + ": relative error on the " + quantity + " in each cell: " + str(error))
+        assert(error < relative_tol)
@@ -0,0 +1,59 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+## In this test, we check that the velocity merging resampling reduces the number of particles
+## and conserves the weight, momentum and energy in each cell, for massive and massless particles.
+## The particles do not move, so the cell of each particle is the same before and after the
+## resampling.
+
+import yt
+import numpy as np
+import sys
+from scipy.constants import c, m_e
+
+fn_final = sys.argv[1]
+fn0 = fn_final[:-4] + '0000'
+
+ds0 = yt.load(fn0)
+ds = yt.load(fn_final)
+
+ad0 = ds0.all_data()
+ad = ds.all_data()
+
+ncells = 8
+relative_tol = 1.e-12 # tolerance for machine precision errors
+
+def cell_sums(ad, species, is_photon):
+    """Sum over each cell of the weight, of the three components of the momentum
+    and of the kinetic energy of the particles (momenta normalized by m_e*c)"""
+    x = ad[species, 'particle_position_x'].to_ndarray()
+    z = ad[species, 'particle_position_y'].to_ndarray()
+    w = ad[species, 'particle_weight'].to_ndarray()
+    u = [ad[species, 'particle_momentum_' + d].to_ndarray()/(m_e*c) for d in ['x', 'y', 'z']]
+    u2 = u[0]**2 + u[1]**2 + u[2]**2
+    energy = np.sqrt(u2) if is_photon else np.sqrt(1. + u2) - 1.
+    cell = (np.floor(x).astype(int) + ncells*np.floor(z).astype(int))
+    sums = [np.bincount(cell, weights=q, minlength=ncells**2)
+            for q in [w, w*u[0], w*u[1], w*u[2], w*energy]]
+    return np.array(sums), w.shape[0]
+
+for species, is_photon in [('electrons', False), ('photons', True)]:
+    sums0, numparts0 = cell_sums(ad0, species, is_photon)
+    sums, numparts = cell_sums(ad, species, is_photon)
+
+    print(species + ": number of particles before and after resampling: "
+          + str(numparts0) + " " + str(numparts))
+    assert(numparts < numparts0)
+
+    for i, quantity in enumerate(['weight', 'x momentum', 'y momentum', 'z momentum', 'energy']):
+        # The scale of each quantity is its largest absolute value over the cells, so that
+        # the error on a component of the momentum that is close to 0 is not amplified
+        scale = np.max(np.abs(sums0[i]))
+        error = np.max(np.abs(sums[i] - sums0[i])) / scale
+        print(species + ": relative error on the " + quantity + " in each cell: " + str(error))
+        assert(error < relative_tol)
@@ -0,0 +1,77 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script checks the resampling of the MCC cross-sections on a logarithmic
+# energy grid (<collision_name>.cross_section_grid = log). It runs the ions of
+# inputs_2d, without charge so that they are only subject to the collisions, twice:
+# - with cross-sections tabulated on equally spaced energies (uniform grid);
+# - with the same cross-sections tabulated on unevenly spaced energies, which are
+#   resampled on a fine logarithmic grid.
+# The cross-sections are linear in energy, so that both interpolations are exact
+# to a very good approximation, and the momenta of the ions must be the same.
+
+import yt ; yt.funcs.mylog.setLevel(50)
+import numpy as np
+import glob
+import os
+
+max_step = 50
+# the cross-sections decrease linearly to 0 at this energy (eV)
+energy_max = 0.3
+sigma_0 = {'elastic': 5.e-19, 'back': 3.e-19}
+
+def write_cross_sections(suffix, energies):
+    for process, sigma in sigma_0.items():
+        np.savetxt('%s_%s.dat' % (process, suffix),
+                   np.column_stack((energies, sigma*(1. - energies/energy_max))))
+
+def run(executable, suffix, grid):
+    args = ' '.join([
+        'max_step=%d' % max_step,
+        'particles.species_names=he_ions',
+        'he_ions.charge=0',
+        'boundary.potential_hi_x=0',
+        'collisions.collision_names=coll_ion',
+        'coll_ion.elastic_cross_section=elastic_%s.dat' % suffix,
+        'coll_ion.back_cross_section=back_%s.dat' % suffix,
+        'coll_ion.cross_section_grid=%s' % grid,
+        'coll_ion.cross_section_points=100000',
+        'diag1.intervals=%d' % max_step,
+        'diag1.fields_to_plot=rho_he_ions',
+        'diag1.file_prefix=diags/%s_plt' % suffix])
+    assert(os.system('./%s inputs_2d %s' % (executable, args)) == 0)
+
+def momenta(suffix, step):
+    ds = yt.load('diags/%s_plt%05d' % (suffix, step))
+    ad = ds.all_data()
+    order = np.argsort(ad['he_ions', 'particle_id'].v)
+    return np.column_stack([ad['he_ions', 'particle_momentum_%s' % d].v[order]
+                            for d in ['x', 'y', 'z']])
+
+executables = glob.glob('main2d*')
+assert(len(executables) == 1)
+
+write_cross_sections('uniform', np.linspace(0., energy_max, 301))
+write_cross_sections('log', np.concatenate(([0.], np.geomspace(1.e-6, energy_max, 150))))
+run(executables[0], 'uniform', 'uniform')
+run(executables[0], 'log', 'log')
+
+u_init = momenta('uniform', 0)
+u_uniform = momenta('uniform', max_step)
+u_log = momenta('log', max_step)
+
+# without fields, only the collisions change the momenta
+n_collided = np.count_nonzero(np.any(u_uniform != u_init, axis=1))
+# the collisions of both runs only differ if the round-off errors of the
+# interpolations change the outcome of a random draw, which is very unlikely
+n_different = np.count_nonzero(np.any(u_log != u_uniform, axis=1))
+print('%d ions collided, %d differ between the grids' % (n_collided, n_different))
+assert(n_collided > 100)
+assert(n_different <= 5)
+
+print('Passed')
@@ -0,0 +1,39 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+## In this test, the autotuner times two candidate particle tile sizes. We check that
+## both candidates were timed, that the selected configuration is one of them and that
+## the anisotropic maximum grid size of the input file, which is not tuned, is kept.
+
+import sys
+import yt
+import numpy as np
+
+fn_final = sys.argv[1]
+
+with open('warpx_autotune.txt') as f:
+    lines = [line.strip() for line in f if line.strip()]
+
+# Timings of the candidates
+timings = [line for line in lines if line.startswith('# amr.max_grid_size')]
+print(timings)
+assert(len(timings) == 2)
+for line in timings:
+    assert(float(line.split(':')[-1].split()[0]) > 0.)
+
+# Selected configuration, with the syntax of the input file
+params = dict(line.split(' = ') for line in lines if not line.startswith('#'))
+print(params)
+assert(params['amr.max_grid_size_x'] == '32')
+assert(params['amr.max_grid_size_y'] == '16')
+assert(params['particles.tile_size'] in ['8 8', '16 16'])
+
+# The grids of the final plotfile still follow the maximum grid size of the input file
+ds = yt.load(fn_final)
+for grid in ds.index.grids:
+    assert(np.all(grid.ActiveDimensions[:2] <= [32, 16]))
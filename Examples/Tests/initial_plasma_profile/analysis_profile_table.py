@@ -0,0 +1,49 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script compares the particles injected with tabulated profiles (species "tabulated")
+# with the particles injected by evaluating the parser for each particle (species "exact").
+# The particles are at the same positions, and their weights and momenta must be close,
+# within the tolerance of the table. Near the sharp edge of the density, the table is not
+# used, so that no particles are injected where the density is zero.
+
+import sys
+import yt
+import numpy as np
+from scipy.constants import c, m_e
+
+filename = sys.argv[1]
+ds = yt.load( filename )
+ad = ds.all_data()
+
+tolerance = 2.e-3
+
+def sorted_particles(species):
+    x = ad[species, 'particle_position_x'].to_ndarray()
+    z = ad[species, 'particle_position_y'].to_ndarray()
+    order = np.lexsort((z, x))
+    w = ad[species, 'particle_weight'].to_ndarray()[order]
+    ux = ad[species, 'particle_momentum_x'].to_ndarray()[order]/(m_e*c)
+    uz = ad[species, 'particle_momentum_z'].to_ndarray()[order]/(m_e*c)
+    return x[order], z[order], w, ux, uz
+
+x, z, w, ux, uz = sorted_particles('tabulated')
+x0, z0, w0, ux0, uz0 = sorted_particles('exact')
+
+# The same particles are injected, in particular none behind the sharp edge
+assert(x.shape == x0.shape)
+assert(np.all(x == x0) and np.all(z == z0))
+assert(np.all(x > 10.5e-6))
+
+for name, q, q0 in [('weight', w, w0), ('ux', ux, ux0), ('uz', uz, uz0)]:
+    error = np.max(np.abs(q - q0)) / np.max(np.abs(q0))
+    print('relative error on the ' + name + ': ' + str(error))
+    assert(error < tolerance)
+
+# The weights are interpolated, and thus not exactly equal to those computed by the parser
+assert(np.max(np.abs(w - w0)) > 0.)
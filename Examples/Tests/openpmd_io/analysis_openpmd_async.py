@@ -0,0 +1,67 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script checks that the openPMD output flushed from a background thread
+# (diag_test, with openpmd_async = 1) is identical to the synchronous output
+# of the same fields and particles (diag_ref).
+
+import numpy as np
+import openpmd_api as io
+
+series_sync = io.Series('diags/diag_ref/openpmd_%T.h5', io.Access.read_only)
+series_async = io.Series('diags/diag_test/openpmd_%T.h5', io.Access.read_only)
+
+iterations = list(series_sync.iterations)
+print('iterations: ', iterations)
+assert(iterations == [0, 10, 20])
+assert(list(series_async.iterations) == iterations)
+
+def read_record(series, record):
+    """Read all the components of a record, as numpy arrays"""
+    data = {name: component.load_chunk() for name, component in record.items()}
+    series.flush()
+    return data
+
+for n in iterations:
+    it_sync = series_sync.iterations[n]
+    it_async = series_async.iterations[n]
+    assert(it_sync.time == it_async.time)
+
+    # fields
+    assert(sorted(it_sync.meshes) == sorted(it_async.meshes))
+    for name in it_sync.meshes:
+        data_sync = read_record(series_sync, it_sync.meshes[name])
+        data_async = read_record(series_async, it_async.meshes[name])
+        assert(data_sync.keys() == data_async.keys())
+        for c in data_sync:
+            print('iteration', n, 'field', name, c)
+            assert(np.array_equal(data_sync[c], data_async[c]))
+
+    # particles, compared after sorting by id since the order of the particles
+    # in the files is not guaranteed to be the same
+    assert(sorted(it_sync.particles) == sorted(it_async.particles))
+    for species in it_sync.particles:
+        ids_sync = read_record(series_sync, it_sync.particles[species]['id'])
+        ids_sync = ids_sync[io.Mesh_Record_Component.SCALAR]
+        ids_async = read_record(series_async, it_async.particles[species]['id'])
+        ids_async = ids_async[io.Mesh_Record_Component.SCALAR]
+        assert(ids_sync.size > 0)
+        order_sync = np.argsort(ids_sync)
+        order_async = np.argsort(ids_async)
+        assert(np.array_equal(ids_sync[order_sync], ids_async[order_async]))
+        for name in it_sync.particles[species]:
+            data_sync = read_record(series_sync, it_sync.particles[species][name])
+            data_async = read_record(series_async, it_async.particles[species][name])
+            for c in data_sync:
+                print('iteration', n, 'species', species, name, c)
+                if np.size(data_sync[c]) != ids_sync.size:
+                    # constant record component, e.g. the charge and mass
+                    assert(np.array_equal(data_sync[c], data_async[c]))
+                    continue
+                assert(np.array_equal(data_sync[c][order_sync],
+                                      data_async[c][order_async]))
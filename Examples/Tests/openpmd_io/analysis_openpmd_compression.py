@@ -0,0 +1,88 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script checks the error-bounded compression of the openPMD output:
+# the output of diag_test, compressed with ZFP using the tolerances below,
+# must be within these tolerances of the uncompressed output of diag_ref,
+# and the particle ids must be identical.
+
+import numpy as np
+import openpmd_api as io
+
+# Same tolerances as in the runtime parameters of the test
+default_tolerance = 1.e-3
+tolerances = {'x': 1.e-9, 'y': 1.e-9, 'z': 1.e-9,
+              'momentum_x': 1.e-26, 'momentum_y': 1.e-26, 'momentum_z': 1.e-26,
+              'weighting': 1.}
+
+series_ref = io.Series('diags/diag_ref/openpmd_%T.bp', io.Access.read_only)
+series_test = io.Series('diags/diag_test/openpmd_%T.bp', io.Access.read_only)
+
+iterations = list(series_ref.iterations)
+print('iterations: ', iterations)
+assert(iterations == [0, 10, 20])
+assert(list(series_test.iterations) == iterations)
+
+def read_record(series, record):
+    """Read all the components of a record, as numpy arrays"""
+    data = {name: component.load_chunk() for name, component in record.items()}
+    series.flush()
+    return data
+
+def check(name, data_ref, data_test):
+    """Check that the compression error of a component is within its tolerance"""
+    tolerance = tolerances.get(name, default_tolerance)
+    error = np.max(np.abs(data_test.astype(np.float64) - data_ref.astype(np.float64)))
+    print('%s: max error %g, tolerance %g' % (name, error, tolerance))
+    assert(error <= tolerance)
+    return np.array_equal(data_ref, data_test)
+
+# whether the positions were written without any loss, which would mean
+# that they were not compressed at all
+positions_exact = True
+
+for n in iterations:
+    it_ref = series_ref.iterations[n]
+    it_test = series_test.iterations[n]
+
+    # fields: the name of the component is the one of fields_to_plot, e.g. Ex
+    for name in it_ref.meshes:
+        data_ref = read_record(series_ref, it_ref.meshes[name])
+        data_test = read_record(series_test, it_test.meshes[name])
+        for c in data_ref:
+            field = name if c == io.Mesh_Record_Component.SCALAR else name + c
+            check(field, data_ref[c], data_test[c])
+
+    for species in it_ref.particles:
+        # the ids are never compressed
+        ids_ref = read_record(series_ref, it_ref.particles[species]['id'])
+        ids_ref = ids_ref[io.Mesh_Record_Component.SCALAR]
+        ids_test = read_record(series_test, it_test.particles[species]['id'])
+        ids_test = ids_test[io.Mesh_Record_Component.SCALAR]
+        assert(ids_ref.size > 0)
+        order_ref = np.argsort(ids_ref)
+        order_test = np.argsort(ids_test)
+        assert(np.array_equal(ids_ref[order_ref], ids_test[order_test]))
+
+        # the name of the component is the one of the particle attribute,
+        # e.g. x, momentum_x or weighting
+        for record in ['position', 'momentum', 'weighting']:
+            data_ref = read_record(series_ref, it_ref.particles[species][record])
+            data_test = read_record(series_test, it_test.particles[species][record])
+            for c in data_ref:
+                if c == io.Mesh_Record_Component.SCALAR:
+                    name = record
+                elif record == 'position':
+                    name = c
+                else:
+                    name = record + '_' + c
+                exact = check(name, data_ref[c][order_ref], data_test[c][order_test])
+                if record == 'position':
+                    positions_exact = positions_exact and exact
+
+assert(not positions_exact)
@@ -0,0 +1,37 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script checks that the histogram computed with the functions compiled by the
+# parser JIT is the same as the histogram computed with the same functions evaluated
+# by the interpreter. The particles are pushed in an external field that is also
+# compiled, so that the histograms differ from the initial distribution.
+
+import glob
+import numpy as np
+
+# The functions of histogram_jit and the external field were compiled
+libraries = glob.glob('parser_jit/warpx_parser_*.so')
+print('compiled libraries: ', libraries)
+assert(len(libraries) >= 4)
+
+h_jit = np.loadtxt('./diags/reducedfiles/histogram_jit.txt')
+h_interp = np.loadtxt('./diags/reducedfiles/histogram_interp.txt')
+
+assert(h_jit.shape == h_interp.shape)
+assert(np.all(h_jit[:,0] == h_interp[:,0]))
+
+# Number of particles in each bin (columns 0 and 1 are the step and the time):
+# the compiled code may round differently from the interpreter, which could move
+# a particle that is exactly at the edge of a bin, so a few particles may differ
+counts_jit = h_jit[:,2:]
+counts_interp = h_interp[:,2:]
+print('number of particles in the histograms: ', np.sum(counts_jit, axis=1))
+assert(np.all(np.sum(counts_interp, axis=1) > 0))
+difference = np.sum(np.abs(counts_jit - counts_interp), axis=1)
+print('number of particles in different bins: ', difference)
+assert(np.all(difference <= 1.e-4*np.sum(counts_interp, axis=1)))
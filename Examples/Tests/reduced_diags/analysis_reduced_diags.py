@@ -286,5 +286,57 @@ for k in values_yt.keys():
     assert(error[k] < tol)
 print()
 
+#--------------------------------------------------------------------------------------------------
+# Part 4: check the timings and the memory usage, which cannot be compared with the plotfiles
+#--------------------------------------------------------------------------------------------------
+
+def read_reduced_diags(name):
+    with open('./diags/reducedfiles/%s.txt' % name) as f:
+        header = f.readline()
+    # column names, without the column index and the unit
+    columns = [h.split(']')[1].split('(')[0] for h in header.split()]
+    data = np.loadtxt('./diags/reducedfiles/%s.txt' % name, ndmin=2)
+    assert(data.shape[1] == len(columns))
+    return columns, {columns[i]: data[:,i] for i in range(len(columns))}
+
+# Step timing: mean, min and max over the ranks of the time per step of each phase
+phases = ['push_deposit', 'field_solve', 'communication', 'diagnostics', 'sorting',
+          'redistribute', 'collisions', 'load_balance']
+stats = ['_mean', '_min', '_max']
+columns, STdata = read_reduced_diags('ST')
+assert(columns == ['step', 'time'] + [p + s for p in phases + ['other', 'total'] for s in stats]
+                  + ['particle_pushes_per_s', 'cell_updates_per_s'])
+for p in phases + ['total']:
+    for s in stats:
+        assert(np.all(STdata[p + s] >= 0.))
+    assert(np.all(STdata[p + '_min'] <= STdata[p + '_mean']*(1. + 1.e-12)))
+    assert(np.all(STdata[p + '_mean'] <= STdata[p + '_max']*(1. + 1.e-12)))
+# the phases are measured within the steps
+phases_mean = sum(STdata[p + '_mean'] for p in phases)
+print('time per step: total %s s, phases %s s' % (STdata['total_mean'], phases_mean))
+assert(np.all(STdata['total_mean'] > 0.))
+assert(np.all(STdata['total_mean'] >= phases_mean*(1. - 1.e-6)))
+assert(np.all(STdata['particle_pushes_per_s'] > 0.))
+assert(np.all(STdata['cell_updates_per_s'] > 0.))
+
+# Memory usage: sum and max over the ranks of the bytes of each category, and max
+# over the ranks of their high-water marks
+categories = ['fields_fp', 'fields_cp', 'fields_aux', 'fields_avg', 'pml', 'spectral', 'eb',
+              'diagnostics', 'electrons', 'protons', 'photons', 'tmp_particle_data',
+              'all_fabs', 'arena_total']
+stats = ['_total', '_max', '_hwm']
+columns, MUdata = read_reduced_diags('MU')
+assert(columns == ['step', 'time'] + [c + s for c in categories for s in stats])
+for c in categories:
+    for s in stats:
+        assert(np.all(MUdata[c + s] >= 0.))
+    assert(np.all(MUdata[c + '_max'] <= MUdata[c + '_total']))
+    assert(np.all(MUdata[c + '_max'] <= MUdata[c + '_hwm']))
+    # a high-water mark cannot decrease
+    assert(np.all(np.diff(MUdata[c + '_hwm']) >= 0.))
+print('bytes of the fine patch fields: %s' % MUdata['fields_fp_total'])
+for c in ['fields_fp', 'electrons', 'protons', 'photons', 'all_fabs']:
+    assert(np.all(MUdata[c + '_total'] > 0.))
+
 test_name = fn[:-9] # Could also be os.path.split(os.getcwd())[1]
 checksumAPI.evaluate_checksum(test_name, fn)
@@ -0,0 +1,51 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script checks the binary format of the reduced diagnostics: each reduced
+# diagnostic is written as text and as binary, with a buffer of several outputs,
+# and the binary preamble and rows must match the text file.
+
+import numpy as np
+
+max_step = 30
+intervals = 2
+
+for name in ['EP', 'EF', 'BR']:
+    with open('diags/reducedfiles/%s_txt.txt' % name) as f:
+        header_txt = f.readline()
+    data_txt = np.loadtxt('diags/reducedfiles/%s_txt.txt' % name, ndmin=2)
+
+    with open('diags/reducedfiles/%s_bin.bin' % name, 'rb') as f:
+        # header row, as in the text format
+        header_bin = f.readline().decode()
+        # preamble: endianness marker, version and number of columns
+        marker, version, ncols = np.fromfile(f, dtype=np.uint32, count=3)
+        dtype = np.dtype(np.float64)
+        if marker != 0x01020304:
+            dtype = dtype.newbyteorder()
+            marker = marker.byteswap()
+            version = version.byteswap()
+            ncols = ncols.byteswap()
+        data_bin = np.fromfile(f, dtype=dtype)
+
+    print(name, ': marker %#x, version %d, %d columns' % (marker, version, ncols))
+    assert(marker == 0x01020304)
+    assert(version == 1)
+    assert(header_bin == header_txt)
+    assert(ncols == data_txt.shape[1])
+    assert(ncols == header_txt.count(']'))
+
+    # all the buffered rows are written, including those of the last, partial buffer
+    assert(data_bin.size % ncols == 0)
+    data_bin = data_bin.reshape(-1, ncols)
+    assert(data_bin.shape == data_txt.shape)
+    assert(data_bin.shape[0] == max_step // intervals)
+    assert(np.array_equal(data_bin[:,0], np.arange(intervals, max_step+1, intervals)))
+
+    # the text format has 15 significant digits
+    assert(np.allclose(data_bin, data_txt, rtol=1.e-13, atol=0.))
@@ -0,0 +1,67 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script checks the FieldSlices reduced diagnostic: the simulation contains a
+# static electric field that is linear in each coordinate, so that the interpolation
+# between the layers of points around each plane is exact, and the slices must
+# match the analytic field at the coordinates of their points.
+
+import numpy as np
+
+max_step = 4
+intervals = 2
+fields = ['Ex', 'Ey', 'Ez', 'Bx', 'jz']
+normals = [2, 0, 1]
+positions = [0.3, 0., -0.5]
+
+def analytic(field, x, y, z):
+    if field == 'Ex':
+        return 1. + 2.*x
+    if field == 'Ey':
+        return 3.*y
+    if field == 'Ez':
+        return -4.*z
+    return np.zeros_like(x)
+
+data = np.loadtxt('diags/reducedfiles/FS.txt', ndmin=2)
+assert(data.shape[0] == max_step // intervals)
+assert(np.all(data[:,0] == np.arange(intervals, max_step+1, intervals)))
+
+# one line per field and plane: name, plane, position, then (n, lo, d) per direction
+slices = []
+with open('diags/reducedfiles/FS_slices.txt') as f:
+    for line in f:
+        if line.startswith('#'):
+            continue
+        words = line.split()
+        slices.append((words[0], int(words[1]), float(words[2]),
+                       [int(n) for n in words[3::3]],
+                       [float(lo) for lo in words[4::3]],
+                       [float(d) for d in words[5::3]]))
+assert(len(slices) == len(fields)*len(positions))
+
+for row in data:
+    col = 2
+    for islice, (field, p, position, n, lo, d) in enumerate(slices):
+        assert(field == fields[islice // len(positions)])
+        assert(p == islice % len(positions))
+        assert(np.isclose(position, positions[p]))
+        # a single layer of points along the normal to the plane
+        assert(n[normals[p]] == 1)
+        assert(np.isclose(lo[normals[p]], positions[p]))
+
+        npts = np.prod(n)
+        values = row[col:col+npts].reshape(n, order='F')
+        col += npts
+
+        x, y, z = np.meshgrid(*[lo[i] + d[i]*np.arange(n[i]) for i in range(3)],
+                              indexing='ij')
+        error = np.max(np.abs(values - analytic(field, x, y, z)))
+        print('%s, plane %d: max error %g' % (field, p, error))
+        assert(error < 1.e-10)
+    assert(col == row.size)
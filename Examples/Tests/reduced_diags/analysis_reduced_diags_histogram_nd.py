@@ -0,0 +1,58 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script checks the ParticleHistogramND reduced diagnostic:
+# - a 1D histogram must be the same as the one of ParticleHistogram,
+# - a 2D phase space (x, ux) must be the same as the histogram of the
+#   particles of the plotfile computed with numpy.histogramdd.
+
+import sys
+import numpy as np
+import yt
+from scipy.constants import c, m_e
+
+fn = sys.argv[1]
+
+# 1D histogram: same bins and function as ParticleHistogram
+h_1d = np.loadtxt('diags/reducedfiles/h_1d.txt', ndmin=2)
+hnd_1d = np.loadtxt('diags/reducedfiles/hnd_1d.txt', ndmin=2)
+assert(h_1d.shape == hnd_1d.shape)
+print('1D histogram: total weight', np.sum(hnd_1d[-1,2:]))
+assert(np.sum(hnd_1d[-1,2:]) > 0.)
+assert(np.allclose(hnd_1d, h_1d, rtol=1.e-12, atol=0.))
+
+# 2D histogram: read the last row of the binary output
+with open('diags/reducedfiles/hnd_2d.bin', 'rb') as f:
+    f.readline()
+    marker, version, ncols = np.fromfile(f, dtype=np.uint32, count=3)
+    dtype = np.dtype(np.float64)
+    if marker != 0x01020304:
+        dtype = dtype.newbyteorder()
+        ncols = ncols.byteswap()
+    hnd_2d = np.fromfile(f, dtype=dtype).reshape(-1, ncols)
+nx, nux = 1050, 1050
+assert(ncols == 2 + nx*nux)
+hist_warpx = hnd_2d[-1,2:].reshape(nx, nux)
+
+# same histogram from the particles of the plotfile
+ds = yt.load(fn)
+ad = ds.all_data()
+x = ad['electrons', 'particle_position_x'].to_ndarray()
+ux = ad['electrons', 'particle_momentum_x'].to_ndarray() / (m_e * c)
+hist_numpy, _ = np.histogramdd(np.column_stack((x, ux)), bins=(nx, nux),
+                               range=((-1., 1.), (-0.04, 0.04)))
+
+# The histograms are in number of particles (unity_particle_weight). A particle
+# at the edge of a bin can be counted in either bin because of the rounding.
+print('2D histogram: %d particles, %d in the histogram'
+      % (x.size, np.sum(hist_warpx)))
+assert(np.sum(hist_warpx) > 0.)
+assert(np.sum(hist_warpx) == np.sum(hist_numpy))
+difference = np.sum(np.abs(hist_warpx - hist_numpy))
+print('number of particles in different bins: ', difference)
+assert(difference <= 4)
@@ -0,0 +1,58 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script tests the re-chopping of the boxes during load balancing
+# (algo.load_balance_rechop), with the reduced diagnostics `LoadBalanceCosts`.
+# The plasma fills only a quarter of the domain, so that the few boxes that contain
+# it bound the efficiency that can be reached by only changing the distribution
+# mapping. We check that these boxes are split at the first load balance, that this
+# improves the efficiency, and that the new boxes are not merged back afterwards.
+
+import numpy as np
+
+# Load costs data; the rows are padded with NaN when the number of boxes changes
+data = np.genfromtxt("./diags/reducedfiles/LBC.txt")
+steps = data[:,0].astype(int)
+data = data[:,2:]
+
+# Compute the number of datafields saved per box
+n_data_fields = 0
+with open("./diags/reducedfiles/LBC.txt") as f:
+    h = f.readlines()[0]
+    unique_headers=[''.join([l for l in w if not l.isdigit()]) for w in h.split()][2::]
+    n_data_fields = len(set(unique_headers))
+
+# Number of boxes and efficiency at an iteration i
+def get_nboxes(i):
+    return np.count_nonzero(~np.isnan(data[i,0::n_data_fields]))
+
+def get_efficiency(i):
+    nboxes = get_nboxes(i)
+    costs = data[i,0::n_data_fields][:nboxes]
+    ranks = data[i,1::n_data_fields][:nboxes].astype(int)
+    rank_to_cost_map = {r:0. for r in set(ranks)}
+    for c, r in zip(costs, ranks):
+        rank_to_cost_map[r] += c
+    efficiencies = np.array(list(rank_to_cost_map.values()))
+    efficiencies /= efficiencies.max()
+    return efficiencies.mean()
+
+nboxes = [get_nboxes(i) for i in range(len(steps))]
+print('number of boxes: ', nboxes)
+
+# The iteration i=2 is load balanced; examine before/after load balance
+efficiency_before, efficiency_after = get_efficiency(1), get_efficiency(2)
+print('load balance efficiency (before load balance): ', efficiency_before)
+print('load balance efficiency (after load balance): ', efficiency_after)
+
+# The expensive boxes are split at the first load balance, which improves the efficiency
+assert(nboxes[2] > nboxes[1])
+assert(efficiency_before < efficiency_after)
+
+# The boxes created by the re-chop are not merged back by the following load balances
+assert(np.all(np.diff(nboxes[2:]) >= 0))
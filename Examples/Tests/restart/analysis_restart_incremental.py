@@ -0,0 +1,46 @@
+#! /usr/bin/env python
+
+# Copyright 2021 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script checks a restart from an incremental checkpoint. The simulation
+# writes a checkpoint every 3 steps, and one checkpoint out of 3 in full: the
+# restart is done from the checkpoint at step 6, which only contains the field
+# boxes that changed since the full checkpoint. The fields and particles at the
+# end of the restarted simulation must be the same as without restart.
+
+import os
+import sys
+import yt
+import numpy as np
+
+tolerance = sys.float_info.epsilon
+print('tolerance = ', tolerance)
+
+filename = sys.argv[1]
+
+# The checkpoint used for the restart is incremental
+assert(os.path.isfile('restart_incremental_chk00006/Level_0/Ex_fp_base'))
+
+ds  = yt.load( filename )
+ds0 = yt.load( 'orig_' + filename )
+
+ad  = ds.covering_grid(level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions)
+ad0 = ds0.covering_grid(level=0, left_edge=ds0.domain_left_edge, dims=ds0.domain_dimensions)
+for field in ['Ex', 'Ey', 'Ez', 'Bx', 'By', 'Bz']:
+    F  = ad[('boxlib', field)].v
+    F0 = ad0[('boxlib', field)].v
+    error = np.max(np.abs(F - F0)) / max(np.max(np.abs(F0)), tolerance)
+    print(field, ' relative error = ', error)
+    assert(error < tolerance)
+
+ad  = ds.all_data()
+ad0 = ds0.all_data()
+for species in ['beam', 'plasma_e']:
+    for component in ['x', 'z']:
+        x  = np.sort(ad[species, 'particle_position_' + component].to_ndarray())
+        x0 = np.sort(ad0[species, 'particle_position_' + component].to_ndarray())
+        assert(np.max(np.abs(x - x0)) < tolerance)
@@ -10,9 +10,11 @@
 
 #include "BoundaryConditions/PML.H"
 #include "BoundaryConditions/PMLComponent.H"
+#include "Diagnostics/IncrementalCheckpoint.H"
 #ifdef WARPX_USE_PSATD
 #   include "FieldSolver/SpectralSolver/SpectralFieldData.H"
 #endif
+#include "Utils/MemoryCounter.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -1149,26 +1151,35 @@ PML::FillBoundaryG (PatchType patch_type)
 }
 
 void
-PML::CheckPoint (const std::string& dir) const
+PML::CheckPoint (const std::string& dir,
+                 const std::function<void(const amrex::MultiFab&, const std::string&)>& write) const
 {
+    auto write_mf = [&] (const amrex::MultiFab& mf, const std::string& path) {
+        if (write) {
+            write(mf, path);
+        } else {
+            VisMF::AsyncWrite(mf, path);
+        }
+    };
+
     if (pml_E_fp[0])
     {
-        VisMF::AsyncWrite(*pml_E_fp[0], dir+"_Ex_fp");
-        VisMF::AsyncWrite(*pml_E_fp[1], dir+"_Ey_fp");
-        VisMF::AsyncWrite(*pml_E_fp[2], dir+"_Ez_fp");
-        VisMF::AsyncWrite(*pml_B_fp[0], dir+"_Bx_fp");
-        VisMF::AsyncWrite(*pml_B_fp[1], dir+"_By_fp");
-        VisMF::AsyncWrite(*pml_B_fp[2], dir+"_Bz_fp");
+        write_mf(*pml_E_fp[0], dir+"_Ex_fp");
+        write_mf(*pml_E_fp[1], dir+"_Ey_fp");
+        write_mf(*pml_E_fp[2], dir+"_Ez_fp");
+        write_mf(*pml_B_fp[0], dir+"_Bx_fp");
+        write_mf(*pml_B_fp[1], dir+"_By_fp");
+        write_mf(*pml_B_fp[2], dir+"_Bz_fp");
     }
 
     if (pml_E_cp[0])
     {
-        VisMF::AsyncWrite(*pml_E_cp[0], dir+"_Ex_cp");
-        VisMF::AsyncWrite(*pml_E_cp[1], dir+"_Ey_cp");
-        VisMF::AsyncWrite(*pml_E_cp[2], dir+"_Ez_cp");
-        VisMF::AsyncWrite(*pml_B_cp[0], dir+"_Bx_cp");
-        VisMF::AsyncWrite(*pml_B_cp[1], dir+"_By_cp");
-        VisMF::AsyncWrite(*pml_B_cp[2], dir+"_Bz_cp");
+        write_mf(*pml_E_cp[0], dir+"_Ex_cp");
+        write_mf(*pml_E_cp[1], dir+"_Ey_cp");
+        write_mf(*pml_E_cp[2], dir+"_Ez_cp");
+        write_mf(*pml_B_cp[0], dir+"_Bx_cp");
+        write_mf(*pml_B_cp[1], dir+"_By_cp");
+        write_mf(*pml_B_cp[2], dir+"_Bz_cp");
     }
 }
 
@@ -1177,25 +1188,44 @@ PML::Restart (const std::string& dir)
 {
     if (pml_E_fp[0])
     {
-        VisMF::Read(*pml_E_fp[0], dir+"_Ex_fp");
-        VisMF::Read(*pml_E_fp[1], dir+"_Ey_fp");
-        VisMF::Read(*pml_E_fp[2], dir+"_Ez_fp");
-        VisMF::Read(*pml_B_fp[0], dir+"_Bx_fp");
-        VisMF::Read(*pml_B_fp[1], dir+"_By_fp");
-        VisMF::Read(*pml_B_fp[2], dir+"_Bz_fp");
+        IncrementalCheckpoint::Read(*pml_E_fp[0], dir+"_Ex_fp");
+        IncrementalCheckpoint::Read(*pml_E_fp[1], dir+"_Ey_fp");
+        IncrementalCheckpoint::Read(*pml_E_fp[2], dir+"_Ez_fp");
+        IncrementalCheckpoint::Read(*pml_B_fp[0], dir+"_Bx_fp");
+        IncrementalCheckpoint::Read(*pml_B_fp[1], dir+"_By_fp");
+        IncrementalCheckpoint::Read(*pml_B_fp[2], dir+"_Bz_fp");
     }
 
     if (pml_E_cp[0])
     {
-        VisMF::Read(*pml_E_cp[0], dir+"_Ex_cp");
-        VisMF::Read(*pml_E_cp[1], dir+"_Ey_cp");
-        VisMF::Read(*pml_E_cp[2], dir+"_Ez_cp");
-        VisMF::Read(*pml_B_cp[0], dir+"_Bx_cp");
-        VisMF::Read(*pml_B_cp[1], dir+"_By_cp");
-        VisMF::Read(*pml_B_cp[2], dir+"_Bz_cp");
+        IncrementalCheckpoint::Read(*pml_E_cp[0], dir+"_Ex_cp");
+        IncrementalCheckpoint::Read(*pml_E_cp[1], dir+"_Ey_cp");
+        IncrementalCheckpoint::Read(*pml_E_cp[2], dir+"_Ez_cp");
+        IncrementalCheckpoint::Read(*pml_B_cp[0], dir+"_Bx_cp");
+        IncrementalCheckpoint::Read(*pml_B_cp[1], dir+"_By_cp");
+        IncrementalCheckpoint::Read(*pml_B_cp[2], dir+"_Bz_cp");
     }
 }
 
+void
+PML::CountMemory (MemoryCounter& counter) const
+{
+    counter.add(pml_E_fp);
+    counter.add(pml_B_fp);
+    counter.add(pml_j_fp);
+    counter.add(pml_E_cp);
+    counter.add(pml_B_cp);
+    counter.add(pml_j_cp);
+    counter.add(pml_F_fp);
+    counter.add(pml_F_cp);
+    counter.add(pml_G_fp);
+    counter.add(pml_G_cp);
+#ifdef WARPX_USE_PSATD
+    if (spectral_solver_fp) spectral_solver_fp->CountMemory(counter);
+    if (spectral_solver_cp) spectral_solver_cp->CountMemory(counter);
+#endif
+}
+
 #ifdef WARPX_USE_PSATD
 void
 PML::PushPSATD (const int lev) {
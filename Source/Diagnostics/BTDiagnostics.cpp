@@ -8,6 +8,7 @@
 #include "Diagnostics/Diagnostics.H"
 #include "Diagnostics/FlushFormats/FlushFormat.H"
 #include "Utils/CoarsenIO.H"
+#include "Utils/MemoryCounter.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXUtil.H"
 #include "WarpX.H"
@@ -20,15 +21,18 @@
 #include <AMReX_CoordSys.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FileSystem.H>
+#include <AMReX_INT.H>
 #include <AMReX_ParallelContext.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
 #include <AMReX_Utility.H>
 
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <memory>
+#include <string>
 #include <vector>
 
 using namespace amrex::literals;
@@ -147,6 +151,12 @@ BTDiagnostics::ReadParameters ()
     if (pp_diag_name.query("buffer_size", m_buffer_size)) {
         if(m_max_box_size < m_buffer_size) m_max_box_size = m_buffer_size;
     }
+    amrex::Real buffer_memory_budget = 0._rt;
+    queryWithParser(pp_diag_name, "buffer_memory_budget", buffer_memory_budget);
+    m_buffer_memory_budget = static_cast<double>(buffer_memory_budget);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_buffer_memory_budget <= 0. || !pp_diag_name.contains("buffer_size"),
+        "buffer_size and buffer_memory_budget cannot both be specified for back-transformed diagnostics");
 
 }
 
@@ -310,6 +320,76 @@ BTDiagnostics::InitializeFieldBufferData ( int i_buffer , int lev)
 #else
     m_snapshot_ncells_lab[i_buffer] = {Nx_lab, Nz_lab};
 #endif
+
+    // All the snapshots have the same number of cells: the buffer size is set once
+    if (m_buffer_memory_budget > 0. && i_buffer == 0 && lev == 0) {
+        SetBufferSizeFromMemoryBudget(i_buffer);
+    }
+}
+
+void
+BTDiagnostics::SetBufferSizeFromMemoryBudget (const int i_buffer)
+{
+    auto & warpx = WarpX::GetInstance();
+    const int myproc = amrex::ParallelDescriptor::MyProc();
+    const int nprocs = amrex::ParallelDescriptor::NProcs();
+
+    // The cell-centered MultiFab in the boosted frame, from which the lab-frame slices are
+    // interpolated, is allocated once for all the snapshots: its boxes on this rank are
+    // taken out of the budget
+    amrex::Long cell_centered_bytes = 0;
+    for (int lev = 0; lev <= warpx.finestLevel(); ++lev) {
+        amrex::BoxArray ba = warpx.boxArray(lev);
+        ba.coarsen(m_crse_ratio);
+        const amrex::DistributionMapping& dm = warpx.DistributionMap(lev);
+        for (int i = 0; i < ba.size(); ++i) {
+            if (dm[i] != myproc) continue;
+            cell_centered_bytes += amrex::grow(ba[i], 1).numPts()
+                * static_cast<amrex::Long>(m_cellcenter_varnames.size() * sizeof(amrex::Real));
+        }
+    }
+    // The particle buffers of the back-transformed diagnostics are not implemented yet
+    // (the species are cleared by TMP_ClearSpeciesDataForBTD), so they use no memory.
+    const double buffer_budget = m_buffer_memory_budget - static_cast<double>(cell_centered_bytes);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(buffer_budget > 0.,
+        m_diag_name + ".buffer_memory_budget is smaller than the cell-centered boosted-frame data ("
+        + std::to_string(cell_centered_bytes) + " bytes on rank " + std::to_string(myproc) + ")");
+
+    // Memory of the share of one lab-frame z-slice of a snapshot on this rank, for all the
+    // output components, with the transverse directions coarsened by the coarsening ratio.
+    // The buffers are chopped in boxes of at most m_max_box_size cells along each direction
+    // (a single box along z), which are distributed over the ranks: a rank holds at most
+    // ceil(nboxes/nprocs) of them.
+    amrex::Long cells_per_slice = 1;
+    amrex::Long cells_per_box = 1;
+    amrex::Long nboxes = 1;
+    for (int idim = 0; idim < AMREX_SPACEDIM-1; ++idim) {
+        const int ncells = std::max(1, m_snapshot_ncells_lab[i_buffer][idim] / m_crse_ratio[idim]);
+        cells_per_slice *= ncells;
+        cells_per_box *= std::min(ncells, m_max_box_size);
+        nboxes *= (ncells + m_max_box_size - 1) / m_max_box_size;
+    }
+    const amrex::Long local_cells_per_slice = std::min(cells_per_slice,
+        ((nboxes + nprocs - 1) / nprocs) * cells_per_box);
+    const double bytes_per_slice = static_cast<double>(local_cells_per_slice)
+        * static_cast<double>(m_varnames.size() * sizeof(amrex::Real));
+    // In the worst case, the buffers of all the snapshots are filled at the same time
+    const double max_slices = buffer_budget / (bytes_per_slice * m_num_buffers);
+    const int nz_lab = std::max(1, m_snapshot_ncells_lab[i_buffer][m_moving_window_dir]);
+    m_buffer_size = static_cast<int>( std::min(max_slices, static_cast<double>(nz_lab)) );
+    // the buffers must fit on all the ranks
+    amrex::ParallelDescriptor::ReduceIntMin(m_buffer_size);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_buffer_size >= 1,
+        "buffer_memory_budget is too small for a single z-slice of each back-transformed snapshot");
+    if (m_buffer_size > m_max_box_size) {
+        amrex::Warning(m_diag_name + ": buffer_memory_budget allows " + std::to_string(m_buffer_size)
+            + " z-slices, but the buffers are limited to the maximum box size of "
+            + std::to_string(m_max_box_size) + " z-slices");
+        m_buffer_size = m_max_box_size;
+    }
+
+    amrex::Print() << m_diag_name << ": buffer_size set to " << m_buffer_size
+                   << " z-slices from buffer_memory_budget\n";
 }
 
 void
@@ -773,3 +853,10 @@ BTDiagnostics::InterleaveFabArrayHeader(std::string Buffer_FabHeader_path,
     snapshot_FabHeader.WriteMultiFabHeader();
 
 }
+
+void
+BTDiagnostics::CountMemory (MemoryCounter& counter) const
+{
+    Diagnostics::CountMemory(counter);
+    counter.add(m_cell_centered_data);
+}
@@ -7,6 +7,7 @@
  */
 #include "BackTransformedDiagnostic.H"
 
+#include "Utils/MemoryCounter.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
@@ -804,9 +805,19 @@ void BackTransformedDiagnostic::Flush(const Geometry& /*geom*/)
     VisMF::SetHeaderVersion(current_version);
 }
 
-
-
-
+void
+BackTransformedDiagnostic::CountMemory(MemoryCounter& counter) const
+{
+    for (const auto& lf_diags : m_LabFrameDiags_) {
+        counter.add(lf_diags->m_data_buffer_);
+        for (const auto& pdata : lf_diags->m_particles_buffer_) {
+            for (int k = 0; k < DiagIdx::nattribs; ++k) {
+                counter.addBytes(static_cast<amrex::Long>(
+                    pdata.GetRealData(k).capacity()*sizeof(amrex::ParticleReal)));
+            }
+        }
+    }
+}
 
 void
 BackTransformedDiagnostic::
@@ -11,6 +11,7 @@
 #include "FlushFormats/FlushFormatPlotfile.H"
 #include "FlushFormats/FlushFormatSensei.H"
 #include "Particles/MultiParticleContainer.H"
+#include "Utils/MemoryCounter.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "Utils/WarpXUtil.H"
@@ -51,6 +52,9 @@ Diagnostics::BaseReadParameters ()
     pp_diag_name.query("file_min_digits", m_file_min_digits);
     pp_diag_name.query("format", m_format);
     pp_diag_name.query("dump_last_timestep", m_dump_last_timestep);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_format == "openpmd" || !pp_diag_name.contains("compression_tolerance"),
+        m_diag_name + ".compression_tolerance is only supported with the openpmd format");
 
     // Query list of grid fields to write to output
     bool varnames_specified = pp_diag_name.queryarr("fields_to_plot", m_varnames);
@@ -259,7 +263,7 @@ Diagnostics::InitBaseData ()
         m_flush_format = std::make_unique<FlushFormatPlotfile>() ;
     } else if (m_format == "checkpoint"){
         // creating checkpoint format
-        m_flush_format = std::make_unique<FlushFormatCheckpoint>() ;
+        m_flush_format = std::make_unique<FlushFormatCheckpoint>(m_diag_name) ;
     } else if (m_format == "ascent"){
         m_flush_format = std::make_unique<FlushFormatAscent>();
     } else if (m_format == "sensei"){
@@ -343,3 +347,9 @@ Diagnostics::FilterComputePackFlush (int step, bool force_flush)
     }
 
 }
+
+void
+Diagnostics::CountMemory (MemoryCounter& counter) const
+{
+    counter.add(m_mf_output);
+}
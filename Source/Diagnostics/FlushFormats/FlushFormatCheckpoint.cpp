@@ -4,9 +4,11 @@
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "Utils/WarpXUtil.H"
 #include "WarpX.H"
 
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_ParticleIO.H>
 #include <AMReX_PlotFileUtil.H>
 #include <AMReX_Print.H>
@@ -21,6 +23,16 @@ namespace
     const std::string default_level_prefix {"Level_"};
 }
 
+FlushFormatCheckpoint::FlushFormatCheckpoint (const std::string& diag_name)
+{
+    ParmParse pp_diag_name(diag_name);
+    pp_diag_name.query("incremental_checkpoint", m_incremental);
+    queryWithParser(pp_diag_name, "full_checkpoint_interval", m_full_checkpoint_interval);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_full_checkpoint_interval > 0,
+        "full_checkpoint_interval must be positive");
+    m_incremental_checkpoint = IncrementalCheckpoint(m_full_checkpoint_interval - 1);
+}
+
 void
 FlushFormatCheckpoint::WriteToFile (
         const amrex::Vector<std::string> /*varnames*/,
@@ -47,6 +59,12 @@ FlushFormatCheckpoint::WriteToFile (
 
     amrex::Print() << "  Writing checkpoint " << checkpointname << "\n";
 
+    // PreBuildDirectorHierarchy renames an existing checkpoint, which would break
+    // the incremental checkpoints that need it to restart
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!IncrementalCheckpoint::HasDependents(checkpointname),
+        ("Checkpoint " + checkpointname + " already exists and incremental checkpoints "
+         "depend on it: move it or change the prefix of the checkpoints").c_str());
+
     // const int nlevels = finestLevel()+1;
     amrex::PreBuildDirectorHierarchy(checkpointname, default_level_prefix, nlev, true);
 
@@ -54,58 +72,78 @@ FlushFormatCheckpoint::WriteToFile (
 
     WriteJobInfo(checkpointname);
 
+    // With incremental checkpoints, each field is written in full every
+    // m_full_checkpoint_interval checkpoints, and the others only contain the boxes
+    // that changed since then
+    auto write_mf = [&] (const amrex::MultiFab& field, const std::string& path) {
+        if (m_incremental) {
+            m_incremental_checkpoint.Write(field, checkpointname, path);
+        } else {
+            VisMF::Write(field, path);
+        }
+    };
+
     for (int lev = 0; lev < nlev; ++lev)
     {
-        VisMF::Write(warpx.getEfield_fp(lev, 0),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_fp"));
-        VisMF::Write(warpx.getEfield_fp(lev, 1),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_fp"));
-        VisMF::Write(warpx.getEfield_fp(lev, 2),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_fp"));
-        VisMF::Write(warpx.getBfield_fp(lev, 0),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_fp"));
-        VisMF::Write(warpx.getBfield_fp(lev, 1),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_fp"));
-        VisMF::Write(warpx.getBfield_fp(lev, 2),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_fp"));
+        write_mf(warpx.getEfield_fp(lev, 0),
+                 amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_fp"));
+        write_mf(warpx.getEfield_fp(lev, 1),
+                 amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_fp"));
+        write_mf(warpx.getEfield_fp(lev, 2),
+                 amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_fp"));
+        write_mf(warpx.getBfield_fp(lev, 0),
+                 amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_fp"));
+        write_mf(warpx.getBfield_fp(lev, 1),
+                 amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_fp"));
+        write_mf(warpx.getBfield_fp(lev, 2),
+                 amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_fp"));
         if (warpx.getis_synchronized()) {
             // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-            VisMF::Write(warpx.getcurrent_fp(lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_fp"));
-            VisMF::Write(warpx.getcurrent_fp(lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_fp"));
-            VisMF::Write(warpx.getcurrent_fp(lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_fp"));
+            write_mf(warpx.getcurrent_fp(lev, 0),
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_fp"));
+            write_mf(warpx.getcurrent_fp(lev, 1),
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_fp"));
+            write_mf(warpx.getcurrent_fp(lev, 2),
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_fp"));
         }
 
         if (lev > 0)
         {
-            VisMF::Write(warpx.getEfield_cp(lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_cp"));
-            VisMF::Write(warpx.getEfield_cp(lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_cp"));
-            VisMF::Write(warpx.getEfield_cp(lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_cp"));
-            VisMF::Write(warpx.getBfield_cp(lev, 0),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_cp"));
-            VisMF::Write(warpx.getBfield_cp(lev, 1),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_cp"));
-            VisMF::Write(warpx.getBfield_cp(lev, 2),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_cp"));
+            write_mf(warpx.getEfield_cp(lev, 0),
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_cp"));
+            write_mf(warpx.getEfield_cp(lev, 1),
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_cp"));
+            write_mf(warpx.getEfield_cp(lev, 2),
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_cp"));
+            write_mf(warpx.getBfield_cp(lev, 0),
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_cp"));
+            write_mf(warpx.getBfield_cp(lev, 1),
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_cp"));
+            write_mf(warpx.getBfield_cp(lev, 2),
+                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_cp"));
             if (warpx.getis_synchronized()) {
                 // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-                VisMF::Write(warpx.getcurrent_cp(lev, 0),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_cp"));
-                VisMF::Write(warpx.getcurrent_cp(lev, 1),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_cp"));
-                VisMF::Write(warpx.getcurrent_cp(lev, 2),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_cp"));
+                write_mf(warpx.getcurrent_cp(lev, 0),
+                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_cp"));
+                write_mf(warpx.getcurrent_cp(lev, 1),
+                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_cp"));
+                write_mf(warpx.getcurrent_cp(lev, 2),
+                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_cp"));
             }
         }
 
         if (warpx.DoPML() && warpx.GetPML(lev)) {
-            warpx.GetPML(lev)->CheckPoint(
-                amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "pml"));
+            if (m_incremental) {
+                // the PML fields are written asynchronously, as without incremental checkpoints
+                warpx.GetPML(lev)->CheckPoint(
+                    amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "pml"),
+                    [&] (const amrex::MultiFab& field, const std::string& path) {
+                        m_incremental_checkpoint.Write(field, checkpointname, path, true);
+                    });
+            } else {
+                warpx.GetPML(lev)->CheckPoint(
+                    amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "pml"));
+            }
         }
     }
 
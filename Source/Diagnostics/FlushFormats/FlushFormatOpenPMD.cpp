@@ -1,6 +1,7 @@
 #include "FlushFormatOpenPMD.H"
 
 #include "Utils/WarpXProfilerWrapper.H"
+#include "Utils/WarpXUtil.H"
 #include "WarpX.H"
 
 #include <AMReX.H>
@@ -76,11 +77,44 @@ FlushFormatOpenPMD::FlushFormatOpenPMD (const std::string& diag_name)
     operator_parameters.insert({k, v});
   }
 
+  // error-bounded lossy compression: the floating-point datasets of the fields and
+  // particles are compressed by the ZFP operator in fixed-accuracy mode, i.e. the
+  // absolute error of each value written is bounded by the tolerance of its component
+  amrex::Real compression_tolerance = 0.;
+  if (queryWithParser(pp_diag_name, "compression_tolerance", compression_tolerance)) {
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(compression_tolerance > 0.,
+        diag_name + ".compression_tolerance must be positive");
+  }
+  std::string const tolerance_prefix = diag_name + ".compression_tolerance";
+  ParmParse pp_tolerance(tolerance_prefix);
+  std::map< std::string, amrex::Real > compression_tolerances;
+  for (std::string k : pp.getEntries(tolerance_prefix)) {
+    // only the entries <diag_name>.compression_tolerance.<component>
+    if (k.size() <= tolerance_prefix.size() + 1 || k[tolerance_prefix.size()] != '.') continue;
+    k.erase(0, tolerance_prefix.size() + 1);
+    amrex::Real tolerance = 0.;
+    queryWithParser(pp_tolerance, k.c_str(), tolerance);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(tolerance >= 0.,
+        tolerance_prefix + "." + k + " must be positive, or 0 to disable the compression");
+    compression_tolerances.insert({k, tolerance});
+  }
+  // the ZFP operator of each dataset would be applied in addition to the series-wide one
+  AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+      operator_type.empty() || (compression_tolerance == 0. && compression_tolerances.empty()),
+      diag_name + ".compression_tolerance cannot be combined with " +
+      diag_name + ".adios2_operator.type = " + operator_type);
+
+  // write the data to disk from a background thread, while the simulation continues
+  bool openpmd_async = false;
+  pp_diag_name.query("openpmd_async", openpmd_async);
+
   auto & warpx = WarpX::GetInstance();
   m_OpenPMDPlotWriter = std::make_unique<WarpXOpenPMDPlot>(
     encoding, openpmd_backend,
     operator_type, operator_parameters,
-    warpx.getPMLdirections()
+    compression_tolerance, compression_tolerances,
+    warpx.getPMLdirections(),
+    openpmd_async
   );
 }
 
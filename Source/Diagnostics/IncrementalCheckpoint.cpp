@@ -0,0 +1,248 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "IncrementalCheckpoint.H"
+
+#include <AMReX_Array4.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_Box.H>
+#include <AMReX_BoxList.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Vector.H>
+#include <AMReX_VisMF.H>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+using namespace amrex;
+
+namespace
+{
+    /** splitmix64 finalizer, used to mix the bits of each value with its position */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    unsigned long long Mix (unsigned long long x) noexcept
+    {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    /** Everything after the last '/' of a path */
+    std::string BaseName (const std::string& path)
+    {
+        const auto pos = path.find_last_of('/');
+        return (pos == std::string::npos) ? path : path.substr(pos+1);
+    }
+
+    /** Everything before the last '/' of a path, or an empty string */
+    std::string DirName (const std::string& path)
+    {
+        const auto pos = path.find_last_of('/');
+        return (pos == std::string::npos) ? std::string() : path.substr(0, pos);
+    }
+
+    /** BoxArray and DistributionMapping made of a subset of the boxes of a MultiFab */
+    std::pair<BoxArray, DistributionMapping>
+    SubsetLayout (const MultiFab& mf, const std::vector<int>& indices)
+    {
+        BoxList bl(mf.ixType());
+        Vector<int> pmap;
+        pmap.reserve(indices.size());
+        for (const int i : indices) {
+            bl.push_back(mf.boxArray()[i]);
+            pmap.push_back(mf.DistributionMap()[i]);
+        }
+        return {BoxArray(std::move(bl)), DistributionMapping(std::move(pmap))};
+    }
+
+    /** Name of the file listing the delta checkpoints that depend on a full one */
+    const std::string dependents_file {"IncrementalCheckpointDependents"};
+}
+
+IncrementalCheckpoint::IncrementalCheckpoint (int max_deltas)
+    : m_max_deltas(max_deltas)
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_max_deltas >= 0,
+        "IncrementalCheckpoint: the number of deltas per full checkpoint must not be negative");
+}
+
+bool
+IncrementalCheckpoint::HasDependents (const std::string& checkpoint_dir)
+{
+    return amrex::FileExists(checkpoint_dir + "/" + dependents_file);
+}
+
+void
+IncrementalCheckpoint::AddDependent (const std::string& base_dir, const std::string& checkpoint_dir)
+{
+    if (!m_dependents.insert({base_dir, checkpoint_dir}).second) return;
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::ofstream ofs(base_dir + "/" + dependents_file, std::ofstream::app);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(ofs.good(),
+            ("IncrementalCheckpoint: could not open " + base_dir + "/" + dependents_file).c_str());
+        ofs << BaseName(checkpoint_dir) << "\n";
+    }
+}
+
+std::map<int, std::uint64_t>
+IncrementalCheckpoint::HashFabs (const MultiFab& mf)
+{
+    std::map<int, std::uint64_t> hashes;
+    const int ncomp = mf.nComp();
+
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+    {
+        const Box& fabbox = mfi.fabbox();
+        Array4<Real const> const& a = mf.const_array(mfi);
+        const auto lo = amrex::lbound(fabbox);
+        const auto len = amrex::length(fabbox);
+
+        // The sum of the mixed values does not depend on the order of the reduction,
+        // and each value is mixed with its position, so that permutations are detected.
+        ReduceOps<ReduceOpSum> reduce_op;
+        ReduceData<unsigned long long> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        reduce_op.eval(fabbox, ncomp, reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) -> ReduceTuple
+            {
+                const Real v = a(i,j,k,n);
+                unsigned long long bits = 0;
+                std::memcpy(&bits, &v, sizeof(Real));
+                const unsigned long long cell = static_cast<unsigned long long>(
+                    (i-lo.x) + len.x*((j-lo.y) + len.y*((k-lo.z) + len.z*n)));
+                return {Mix(bits ^ Mix(cell))};
+            });
+        hashes[mfi.index()] = static_cast<std::uint64_t>(amrex::get<0>(reduce_data.value()));
+    }
+    return hashes;
+}
+
+void
+IncrementalCheckpoint::Write (const MultiFab& mf, const std::string& checkpoint_dir,
+                              const std::string& path, bool async)
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+        path.size() > checkpoint_dir.size() && path.compare(0, checkpoint_dir.size(), checkpoint_dir) == 0,
+        "IncrementalCheckpoint: the MultiFab must be written inside the checkpoint directory");
+    const std::string name = path.substr(checkpoint_dir.size()+1);
+
+    auto write = [async] (const MultiFab& a, const std::string& a_path) {
+        if (async) {
+            VisMF::AsyncWrite(a, a_path);
+        } else {
+            VisMF::Write(a, a_path);
+        }
+    };
+
+    // A MultiFab whose layout changed (e.g. after load balancing) starts a new base,
+    // and so does a MultiFab with m_max_deltas deltas, so that the deltas stay small
+    // and the base checkpoints can be deleted after a while
+    auto base = m_base.find(name);
+    if (base == m_base.end() || base->second.ndeltas >= m_max_deltas ||
+        !(base->second.ba == mf.boxArray()) || !(base->second.dm == mf.DistributionMap()))
+    {
+        write(mf, path);
+        m_base[name] = BaseData{checkpoint_dir, mf.boxArray(), mf.DistributionMap(), HashFabs(mf), 0};
+        return;
+    }
+    ++base->second.ndeltas;
+    AddDependent(base->second.checkpoint_dir, checkpoint_dir);
+
+    // Flag the boxes that changed since the base checkpoint
+    const auto hashes = HashFabs(mf);
+    const auto& base_hashes = base->second.hashes;
+    Vector<int> is_changed(mf.size(), 0);
+    for (const auto& h : hashes) {
+        const auto it = base_hashes.find(h.first);
+        if (it == base_hashes.end() || it->second != h.second) is_changed[h.first] = 1;
+    }
+    ParallelDescriptor::ReduceIntMax(is_changed.dataPtr(), is_changed.size());
+
+    std::vector<int> changed;
+    for (int i = 0; i < mf.size(); ++i) {
+        if (is_changed[i]) changed.push_back(i);
+    }
+
+    // Small text file recording the base checkpoint and the boxes written in this one
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::ofstream ofs(path + "_base");
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(ofs.good(),
+            ("IncrementalCheckpoint: could not open " + path + "_base").c_str());
+        ofs << BaseName(base->second.checkpoint_dir) << "\n" << name << "\n" << changed.size() << "\n";
+        for (const int i : changed) ofs << i << "\n";
+    }
+
+    if (changed.empty()) return;
+
+    // The boxes keep their owner, so that the copy is local
+    const auto layout = SubsetLayout(mf, changed);
+    MultiFab delta(layout.first, layout.second, mf.nComp(), mf.nGrowVect());
+    for (MFIter mfi(delta); mfi.isValid(); ++mfi)
+    {
+        const Box& fabbox = mfi.fabbox();
+        delta[mfi].copy<RunOn::Device>(mf[changed[mfi.index()]], fabbox, 0, fabbox, 0, mf.nComp());
+    }
+    write(delta, path);
+}
+
+void
+IncrementalCheckpoint::Read (MultiFab& mf, const std::string& path)
+{
+    const std::string base_file = path + "_base";
+    if (!amrex::FileExists(base_file))
+    {
+        // Written in full
+        VisMF::Read(mf, path);
+        return;
+    }
+
+    Vector<char> file_chars;
+    ParallelDescriptor::ReadAndBcastFile(base_file, file_chars);
+    std::istringstream is(file_chars.dataPtr());
+    std::string base_name, name;
+    int nchanged = 0;
+    is >> base_name >> name >> nchanged;
+    std::vector<int> changed(nchanged);
+    for (auto& i : changed) is >> i;
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!is.fail(),
+        ("IncrementalCheckpoint: could not parse " + base_file).c_str());
+
+    // The base checkpoint is next to this one
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+        path.size() > name.size() && path.compare(path.size()-name.size(), name.size(), name) == 0,
+        ("IncrementalCheckpoint: " + base_file + " does not match " + path).c_str());
+    const std::string checkpoint_dir = path.substr(0, path.size()-name.size()-1);
+    const std::string parent_dir = DirName(checkpoint_dir);
+    const std::string base_path = (parent_dir.empty() ? "" : parent_dir + "/") + base_name + "/" + name;
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(amrex::FileExists(base_path + "_H"),
+        ("IncrementalCheckpoint: the base checkpoint " + base_path + " of " + path + " is missing").c_str());
+
+    VisMF::Read(mf, base_path);
+    if (changed.empty()) return;
+
+    const auto layout = SubsetLayout(mf, changed);
+    MultiFab delta(layout.first, layout.second, mf.nComp(), mf.nGrowVect());
+    VisMF::Read(delta, path);
+    for (MFIter mfi(delta); mfi.isValid(); ++mfi)
+    {
+        const Box& fabbox = mfi.fabbox();
+        mf[changed[mfi.index()]].copy<RunOn::Device>(delta[mfi], fabbox, 0, fabbox, 0, mf.nComp());
+    }
+}
@@ -94,3 +94,11 @@ MultiDiagnostics::NewIteration ()
         diag->NewIteration();
     }
 }
+
+void
+MultiDiagnostics::CountMemory (MemoryCounter& counter) const
+{
+    for( auto const& diag : alldiags ){
+        diag->CountMemory(counter);
+    }
+}
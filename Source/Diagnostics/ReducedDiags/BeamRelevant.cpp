@@ -6,6 +6,7 @@
  */
 #include "BeamRelevant.H"
 
+#include "Diagnostics/ReducedDiags/ParticleMoments.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -13,11 +14,9 @@
 #include "Utils/WarpXConst.H"
 #include "WarpX.H"
 
-#include <AMReX_GpuQualifiers.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
-#include <AMReX_ParticleReduce.H>
 #include <AMReX_Particles.H>
 #include <AMReX_REAL.H>
 
@@ -134,16 +133,6 @@ void BeamRelevant::ComputeDiags (int step)
     // get species names (std::vector<std::string>)
     auto const species_names = mypc.GetSpeciesNames();
 
-    // inverse of speed of light squared
-    Real constexpr inv_c2 = 1.0_rt / (PhysConst::c * PhysConst::c);
-
-    // If 2D-XZ, p.pos(1) is z, rather than p.pos(2).
-#if (defined WARPX_DIM_3D)
-    int const index_z = 2;
-#elif (defined WARPX_DIM_XZ || defined WARPX_DIM_RZ)
-    int const index_z = 1;
-#endif
-
     // loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
@@ -157,15 +146,12 @@ void BeamRelevant::ComputeDiags (int step)
         Real const m = myspc.getMass();
         Real const q = myspc.getCharge();
 
-        using PType = typename WarpXParticleContainer::SuperParticleType;
+        // all moments are computed in a single pass over the particles,
+        // which is shared with the other particle reduced diagnostics
+        ParticleMomentsData const & moments = ParticleMoments::Get(i_s);
 
         // weight sum
-        Real w_sum = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.rdata(PIdx::w); });
-
-        // reduced sum over mpi ranks
-        ParallelDescriptor::ReduceRealSum(w_sum);
+        Real const w_sum = moments.w_sum;
 
         if (w_sum < std::numeric_limits<Real>::min() )
         {
@@ -175,249 +161,37 @@ void BeamRelevant::ComputeDiags (int step)
             return;
         }
 
-#if (defined WARPX_DIM_RZ)
-        // x mean
-        Real x_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.pos(0)*std::cos(p.rdata(PIdx::theta)) * p.rdata(PIdx::w); });
-#else
-        // x mean
-        Real x_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.pos(0) * p.rdata(PIdx::w); });
-#endif
-
-#if (defined WARPX_DIM_3D)
-        // y mean
-        Real y_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.pos(1) * p.rdata(PIdx::w); });
-#elif (defined WARPX_DIM_RZ)
-        // y mean
-        Real y_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.pos(0)*std::sin(p.rdata(PIdx::theta)) * p.rdata(PIdx::w); });
-#endif
-
-        // z mean
-        Real z_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.pos(index_z) * p.rdata(PIdx::w); });
-
-        // ux mean
-        Real ux_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.rdata(PIdx::ux) * p.rdata(PIdx::w); });
-
-        // uy mean
-        Real uy_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.rdata(PIdx::uy) * p.rdata(PIdx::w); });
-
-        // uz mean
-        Real uz_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        { return p.rdata(PIdx::uz) * p.rdata(PIdx::w); });
-
-        // gamma mean
-        Real gm_mean = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real ux = p.rdata(PIdx::ux);
-            Real uy = p.rdata(PIdx::uy);
-            Real uz = p.rdata(PIdx::uz);
-            Real us = ux*ux + uy*uy + uz*uz;
-            return std::sqrt(1.0_rt + us*inv_c2) * p.rdata(PIdx::w);
-        });
-
-        // reduced sum over mpi ranks
-        ParallelDescriptor::ReduceRealSum(x_mean);  x_mean  /= w_sum;
+        // means
+        Real const x_mean  = moments.mean[MomentIdx::x];
 #if (defined WARPX_DIM_3D || defined WARPX_DIM_RZ)
-        ParallelDescriptor::ReduceRealSum(y_mean);  y_mean  /= w_sum;
-#endif
-        ParallelDescriptor::ReduceRealSum(z_mean);  z_mean  /= w_sum;
-        ParallelDescriptor::ReduceRealSum(ux_mean); ux_mean /= w_sum;
-        ParallelDescriptor::ReduceRealSum(uy_mean); uy_mean /= w_sum;
-        ParallelDescriptor::ReduceRealSum(uz_mean); uz_mean /= w_sum;
-        ParallelDescriptor::ReduceRealSum(gm_mean); gm_mean /= w_sum;
-
-#if (defined WARPX_DIM_RZ)
-        // x mean square
-        Real x_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const x = p.pos(0)*std::cos(p.rdata(PIdx::theta));
-            Real const a = (x-x_mean) * (x-x_mean);
-            return a * p.rdata(PIdx::w);
-        });
-#else
-        // x mean square
-        Real x_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.pos(0)-x_mean) * (p.pos(0)-x_mean);
-            return a * p.rdata(PIdx::w);
-        });
-#endif
-
-#if (defined WARPX_DIM_3D)
-        // y mean square
-        Real y_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.pos(1)-y_mean) * (p.pos(1)-y_mean);
-            return a * p.rdata(PIdx::w);
-        });
-#elif (defined WARPX_DIM_RZ)
-        // y mean square
-        Real y_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const y = p.pos(0)*std::sin(p.rdata(PIdx::theta));
-            Real const a = (y-y_mean) * (y-y_mean);
-            return a * p.rdata(PIdx::w);
-        });
-#endif
-
-        // z mean square
-        Real z_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.pos(index_z)-z_mean) * (p.pos(index_z)-z_mean);
-            return a * p.rdata(PIdx::w);
-        });
-
-        // ux mean square
-        Real ux_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.rdata(PIdx::ux)-ux_mean) *
-                           (p.rdata(PIdx::ux)-ux_mean);
-            return a * p.rdata(PIdx::w);
-        });
-
-        // uy mean square
-        Real uy_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.rdata(PIdx::uy)-uy_mean) *
-                           (p.rdata(PIdx::uy)-uy_mean);
-            return a * p.rdata(PIdx::w);
-        });
-
-        // uz mean square
-        Real uz_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.rdata(PIdx::uz)-uz_mean) *
-                           (p.rdata(PIdx::uz)-uz_mean);
-            return a * p.rdata(PIdx::w);
-        });
-
-        // gamma mean square
-        Real gm_ms = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const ux = p.rdata(PIdx::ux);
-            Real const uy = p.rdata(PIdx::uy);
-            Real const uz = p.rdata(PIdx::uz);
-            Real const us = ux*ux + uy*uy + uz*uz;
-            Real const gm = std::sqrt(1.0_rt + us*inv_c2);
-            Real const a  = (gm - gm_mean) * (gm - gm_mean);
-            return a * p.rdata(PIdx::w);
-        });
-
-#if (defined WARPX_DIM_RZ)
-        // x times ux
-        Real xux = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const x = p.pos(0)*std::cos(p.rdata(PIdx::theta));
-            Real const a = (x-x_mean) * (p.rdata(PIdx::ux)-ux_mean);
-            return a * p.rdata(PIdx::w);
-        });
-#else
-        // x times ux
-        Real xux = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.pos(0)-x_mean) * (p.rdata(PIdx::ux)-ux_mean);
-            return a * p.rdata(PIdx::w);
-        });
+        Real const y_mean  = moments.mean[MomentIdx::y];
 #endif
-
-#if (defined WARPX_DIM_3D)
-        // y times uy
-        Real yuy = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.pos(1)-y_mean) * (p.rdata(PIdx::uy)-uy_mean);
-            return a * p.rdata(PIdx::w);
-        });
-#elif (defined WARPX_DIM_RZ)
-        // y times uy
-        Real yuy = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const y = p.pos(0)*std::sin(p.rdata(PIdx::theta));
-            Real const a = (y-y_mean) * (p.rdata(PIdx::uy)-uy_mean);
-            return a * p.rdata(PIdx::w);
-        });
-#endif
-
-        // z times uz
-        Real zuz = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const a = (p.pos(index_z)-z_mean) * (p.rdata(PIdx::uz)-uz_mean);
-            return a * p.rdata(PIdx::w);
-        });
-
-        // charge
-        Real charge = ReduceSum( myspc,
-        [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real
-        {
-            Real const w = p.rdata(PIdx::w);
-            return q * w;
-        });
-
-        // reduced sum over mpi ranks
-        ParallelDescriptor::ReduceRealSum
-            ( x_ms, ParallelDescriptor::IOProcessorNumber());
-        x_ms /= w_sum;
+        Real const z_mean  = moments.mean[MomentIdx::z];
+        Real const ux_mean = moments.mean[MomentIdx::ux];
+        Real const uy_mean = moments.mean[MomentIdx::uy];
+        Real const uz_mean = moments.mean[MomentIdx::uz];
+        Real const gm_mean = moments.mean[MomentIdx::gamma];
+
+        // mean squares
+        Real const x_ms  = moments.var[MomentIdx::x];
 #if (defined WARPX_DIM_3D || defined WARPX_DIM_RZ)
-        ParallelDescriptor::ReduceRealSum
-            ( y_ms, ParallelDescriptor::IOProcessorNumber());
-        y_ms /= w_sum;
+        Real const y_ms  = moments.var[MomentIdx::y];
 #endif
-        ParallelDescriptor::ReduceRealSum
-            ( z_ms, ParallelDescriptor::IOProcessorNumber());
-        z_ms /= w_sum;
-        ParallelDescriptor::ReduceRealSum
-            (ux_ms, ParallelDescriptor::IOProcessorNumber());
-        ux_ms /= w_sum;
-        ParallelDescriptor::ReduceRealSum
-            (uy_ms, ParallelDescriptor::IOProcessorNumber());
-        uy_ms /= w_sum;
-        ParallelDescriptor::ReduceRealSum
-            (uz_ms, ParallelDescriptor::IOProcessorNumber());
-        uz_ms /= w_sum;
-        ParallelDescriptor::ReduceRealSum
-            (gm_ms, ParallelDescriptor::IOProcessorNumber());
-        gm_ms /= w_sum;
-        ParallelDescriptor::ReduceRealSum
-            (   xux, ParallelDescriptor::IOProcessorNumber());
-        xux /= w_sum;
+        Real const z_ms  = moments.var[MomentIdx::z];
+        Real const ux_ms = moments.var[MomentIdx::ux];
+        Real const uy_ms = moments.var[MomentIdx::uy];
+        Real const uz_ms = moments.var[MomentIdx::uz];
+        Real const gm_ms = moments.var[MomentIdx::gamma];
+
+        // position times momentum
+        Real const xux = moments.cov[0];
 #if (defined WARPX_DIM_3D || defined WARPX_DIM_RZ)
-        ParallelDescriptor::ReduceRealSum
-            (   yuy, ParallelDescriptor::IOProcessorNumber());
-        yuy /= w_sum;
+        Real const yuy = moments.cov[1];
 #endif
-        ParallelDescriptor::ReduceRealSum
-            (   zuz, ParallelDescriptor::IOProcessorNumber());
-        zuz /= w_sum;
-        ParallelDescriptor::ReduceRealSum
-            ( charge, ParallelDescriptor::IOProcessorNumber());
+        Real const zuz = moments.cov[2];
+
+        // charge
+        Real const charge = q * w_sum;
 
         // save data
 #if (defined WARPX_DIM_3D || defined WARPX_DIM_RZ)
@@ -0,0 +1,215 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "FieldSlices.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Diagnostics/SliceDiagnostic.H"
+#include "Utils/IntervalsParser.H"
+#include "Utils/WarpXUtil.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_Box.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_Config.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_INT.H>
+#include <AMReX_IndexType.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace amrex;
+
+namespace
+{
+    /** Field of level 0 from its name */
+    const MultiFab& GetField (const std::string& name)
+    {
+        auto & warpx = WarpX::GetInstance();
+        const int dir = name[1] - 'x';
+        if (name[0] == 'E') return warpx.getEfield(0, dir);
+        if (name[0] == 'B') return warpx.getBfield(0, dir);
+        return warpx.getcurrent_fp(0, dir);
+    }
+
+    /** Unit of a field from its name */
+    std::string GetUnit (const std::string& name)
+    {
+        if (name[0] == 'E') return "(V/m)";
+        if (name[0] == 'B') return "(T)";
+        return "(A/m^2)";
+    }
+}
+
+// constructor
+FieldSlices::FieldSlices (std::string rd_name)
+: ReducedDiags{rd_name}
+{
+    ParmParse pp_rd_name(rd_name);
+
+    // read the fields
+    m_fields = {"Ex", "Ey", "Ez", "Bx", "By", "Bz"};
+    pp_rd_name.queryarr("fields", m_fields);
+    for (const auto& field : m_fields)
+    {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(field.size() == 2
+            && (field[0] == 'E' || field[0] == 'B' || field[0] == 'j')
+            && field[1] >= 'x' && field[1] <= 'z',
+            "FieldSlices: unknown field " + field + ", must be one of Ex, Ey, Ez, Bx, By, Bz, jx, jy or jz");
+    }
+
+    // read the planes: direction normal to each plane and position along it
+    std::vector<std::string> normals;
+    std::vector<Real> positions;
+    pp_rd_name.getarr("normals", normals);
+    getArrWithParser(pp_rd_name, "positions", positions);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(normals.size() == positions.size(),
+        "FieldSlices: normals and positions must have the same number of elements");
+    for (std::size_t p = 0; p < normals.size(); ++p)
+    {
+        // AMReX convention in 2D: x = first dimension, z = second dimension
+#if (AMREX_SPACEDIM == 3)
+        const std::vector<std::string> axes = {"x", "y", "z"};
+#else
+        const std::vector<std::string> axes = {"x", "z"};
+#endif
+        int dir = -1;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (normals[p] == axes[idim]) dir = idim;
+        }
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(dir >= 0,
+            "FieldSlices: invalid normal " + normals[p]);
+        m_planes.push_back(SlicePlane{dir, positions[p]});
+    }
+}
+// end constructor
+
+// function that extracts the slices
+void FieldSlices::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    // get a reference to WarpX instance
+    auto & warpx = WarpX::GetInstance();
+    const Geometry& geom = warpx.Geom(0);
+
+    const int nplanes = m_planes.size();
+    const bool is_first_output = m_data.empty();
+    Vector<Box> boxes;
+
+    std::size_t offset = 0;
+    for (const auto& field : m_fields)
+    {
+        // all the planes of this field at once
+        const auto slices = ExtractSlices(GetField(field), geom, m_planes, 0, 1);
+
+        for (int p = 0; p < nplanes; ++p)
+        {
+            // gather the slice on the I/O rank, in a single box
+            const Box box = slices[p]->boxArray().minimalBox();
+            const DistributionMapping dm(Vector<int>{ParallelDescriptor::IOProcessorNumber()});
+            MultiFab gathered(BoxArray(box), dm, 1, 0);
+            gathered.ParallelCopy(*slices[p]);
+
+            if (is_first_output) {
+                boxes.push_back(box);
+                m_data.resize(m_data.size() + box.numPts(), 0.0_rt);
+            }
+
+            // copy the values of the points, with x varying fastest, to m_data
+            for (MFIter mfi(gathered); mfi.isValid(); ++mfi)
+            {
+                const FArrayBox& fab = gathered[mfi];
+                amrex::Gpu::copy(amrex::Gpu::deviceToHost,
+                    fab.dataPtr(), fab.dataPtr() + box.numPts(), m_data.begin() + offset);
+            }
+            offset += box.numPts();
+        }
+    }
+
+    if (is_first_output && ParallelDescriptor::IOProcessor() && m_IsNotRestart)
+    {
+        WriteHeader(boxes, geom);
+    }
+
+    /* m_data now contains up-to-date values for:
+     *  [values of all the points of each plane of each field] */
+}
+// end void FieldSlices::ComputeDiags
+
+void FieldSlices::WriteHeader (const Vector<Box>& boxes, const Geometry& geom) const
+{
+    // write header row: one column per point of each slice
+    std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+    int c = 0;
+    ofs << "#";
+    ofs << "[" << c++ << "]step()";
+    ofs << m_sep;
+    ofs << "[" << c++ << "]time(s)";
+    int islice = 0;
+    for (const auto& field : m_fields)
+    {
+        for (int p = 0; p < static_cast<int>(m_planes.size()); ++p)
+        {
+            for (Long i = 0; i < boxes[islice].numPts(); ++i)
+            {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << field << "_plane" << p << "_" << i << GetUnit(field);
+            }
+            ++islice;
+        }
+    }
+    ofs << std::endl;
+    ofs.close();
+
+    // write the coordinates of the points of each slice: for each direction, the
+    // number of points, the coordinate of the first point and the spacing
+    std::ofstream ofs_slices{m_path + m_rd_name + "_slices.txt", std::ofstream::out};
+    ofs_slices << std::setprecision(14) << std::scientific;
+    ofs_slices << "# field plane position";
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        ofs_slices << " n" << idim << " lo" << idim << " d" << idim;
+    }
+    ofs_slices << std::endl;
+    islice = 0;
+    for (const auto& field : m_fields)
+    {
+        for (int p = 0; p < static_cast<int>(m_planes.size()); ++p)
+        {
+            const Box& box = boxes[islice];
+            ofs_slices << field << m_sep << p << m_sep << m_planes[p].position;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+            {
+                const Real shift = box.ixType().cellCentered(idim) ? 0.5_rt : 0.0_rt;
+                const Real lo = (idim == m_planes[p].dir) ? m_planes[p].position :
+                    geom.ProbLo(idim) + (box.smallEnd(idim) - geom.Domain().smallEnd(idim) + shift)
+                    * geom.CellSize(idim);
+                ofs_slices << m_sep << box.length(idim) << m_sep << lo
+                           << m_sep << geom.CellSize(idim);
+            }
+            ofs_slices << std::endl;
+            ++islice;
+        }
+    }
+    ofs_slices.close();
+}
@@ -11,6 +11,7 @@
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "WarpX.H"
 
+#include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
 #include <AMReX_Config.H>
 #include <AMReX_DistributionMapping.H>
@@ -37,6 +38,10 @@ using namespace amrex;
 LoadBalanceCosts::LoadBalanceCosts (std::string rd_name)
     : ReducedDiags{rd_name}
 {
+    // the number of columns changes with the number of boxes, and the file
+    // is rewritten at the last step: rows are written as text when computed
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_output_format == "text" && m_buffer_size == 1,
+        "LoadBalanceCosts only supports output_format = text and buffer_size = 1");
 }
 
 // function that gathers costs
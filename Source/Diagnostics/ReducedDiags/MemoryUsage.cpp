@@ -0,0 +1,163 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "MemoryUsage.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/IntervalsParser.H"
+#include "WarpX.H"
+
+#include <AMReX_Arena.H>
+#include <AMReX_BaseFab.H>
+#include <AMReX_CArena.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <algorithm>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+using namespace amrex;
+
+amrex::Vector<amrex::Long> MemoryUsage::s_bytes;
+amrex::Vector<amrex::Long> MemoryUsage::s_hwm;
+
+// constructor
+MemoryUsage::MemoryUsage (std::string rd_name)
+    : ReducedDiags{rd_name}
+{
+    // get species names
+    const auto species_names = WarpX::GetInstance().GetPartContainer().GetSpeciesNames();
+
+    // the categories, in the order in which they are computed in ComputeDiags
+    std::vector<std::string> names = {"fields_fp", "fields_cp", "fields_aux", "fields_avg",
+                                      "pml", "spectral", "eb", "diagnostics"};
+    for (const auto& species_name : species_names) {
+        names.push_back(species_name);
+    }
+    names.push_back("tmp_particle_data");
+    // totals, which include the memory of the categories above
+    names.push_back("all_fabs");
+    names.push_back("arena_total");
+    const int ncat = static_cast<int>(names.size());
+
+    // resize data array: total, max and high-water mark of each category
+    m_data.resize(3*ncat, 0.0_rt);
+    // enable the sampling
+    s_bytes.resize(ncat, 0);
+    s_hwm.resize(ncat, 0);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        if ( m_IsNotRestart )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (const auto& name : names)
+            {
+                for (const auto& stat : {"_total", "_max", "_hwm"})
+                {
+                    ofs << m_sep;
+                    ofs << "[" << c++ << "]" << name << stat << "(B)";
+                }
+            }
+            ofs << std::endl;
+
+            // close file
+            ofs.close();
+        }
+    }
+}
+
+// compute the bytes of each category on this rank and update their high-water marks
+void MemoryUsage::Sample ()
+{
+    // no MemoryUsage reduced diagnostic
+    if (s_hwm.empty()) { return; }
+
+    // get a reference to WarpX instance
+    auto & warpx = WarpX::GetInstance();
+
+    const int ncat = static_cast<int>(s_hwm.size());
+    amrex::Vector<Long> bytes;
+    bytes.reserve(ncat);
+
+    const auto fields = warpx.ComputeFieldMemoryUsage();
+    bytes.push_back(fields.fp);
+    bytes.push_back(fields.cp);
+    bytes.push_back(fields.aux);
+    bytes.push_back(fields.avg);
+    bytes.push_back(fields.pml);
+    bytes.push_back(fields.spectral);
+    bytes.push_back(fields.eb);
+    bytes.push_back(fields.diagnostics);
+
+    const auto & mypc = warpx.GetPartContainer();
+    Long tmp_bytes = 0;
+    for (int i_s = 0; i_s < mypc.nSpecies(); ++i_s)
+    {
+        const auto & myspc = mypc.GetParticleContainer(i_s);
+        bytes.push_back(myspc.ParticleDataBytes());
+        tmp_bytes += myspc.TmpParticleDataBytes();
+    }
+    bytes.push_back(tmp_bytes);
+
+    // all the FABs allocated by AMReX on this rank, including the temporary ones
+    bytes.push_back(amrex::TotalBytesAllocatedInFabs());
+
+    // memory used in the default arena, if it is a CArena
+    const auto* arena = dynamic_cast<CArena*>(amrex::The_Arena());
+    bytes.push_back(arena ? static_cast<Long>(arena->heap_space_used()) : 0);
+
+    // update the high-water marks; AMReX records the exact one for the FABs
+    for (int i = 0; i < ncat; ++i)
+    {
+        s_hwm[i] = std::max(s_hwm[i], bytes[i]);
+    }
+    s_hwm[ncat-2] = std::max(s_hwm[ncat-2], amrex::TotalBytesAllocatedInFabsHWM());
+
+    s_bytes = std::move(bytes);
+}
+
+// compute the bytes of each category
+void MemoryUsage::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    // reduce over the MPI ranks the bytes of each category sampled at this step
+    const int ncat = static_cast<int>(s_bytes.size());
+    amrex::Vector<Long> total = s_bytes;
+    amrex::Vector<Long> max = s_bytes;
+    amrex::Vector<Long> hwm = s_hwm;
+    ParallelDescriptor::ReduceLongSum(total.data(), ncat);
+    ParallelDescriptor::ReduceLongMax(max.data(), ncat);
+    ParallelDescriptor::ReduceLongMax(hwm.data(), ncat);
+
+    for (int i = 0; i < ncat; ++i)
+    {
+        m_data[3*i  ] = static_cast<Real>(total[i]);
+        m_data[3*i+1] = static_cast<Real>(max[i]);
+        m_data[3*i+2] = static_cast<Real>(hwm[i]);
+    }
+
+    /* m_data now contains up-to-date values for:
+     *  [sum over the ranks, max over the ranks and max over the ranks of the
+     *   high-water mark of the bytes of: the fine patch, coarse patch, auxiliary
+     *   and time-averaged fields, the PML, the spectral solvers, the embedded
+     *   boundaries, the diagnostics, each species, tmp_particle_data, and the
+     *   totals of all the FABs and of the default arena] */
+}
@@ -11,14 +11,19 @@
 #include "FieldMaximum.H"
 #include "FieldMomentum.H"
 #include "FieldReduction.H"
+#include "FieldSlices.H"
 #include "LoadBalanceCosts.H"
 #include "LoadBalanceEfficiency.H"
+#include "MemoryUsage.H"
 #include "ParticleEnergy.H"
 #include "ParticleExtrema.H"
 #include "ParticleHistogram.H"
+#include "ParticleHistogramND.H"
+#include "ParticleMoments.H"
 #include "ParticleMomentum.H"
 #include "ParticleNumber.H"
 #include "RhoMaximum.H"
+#include "StepTiming.H"
 #include "Utils/IntervalsParser.H"
 
 #include <AMReX.H>
@@ -52,13 +57,17 @@ MultiReducedDiags::MultiReducedDiags ()
             {"FieldMomentum",         [](CS s){return std::make_unique<FieldMomentum>(s);}},
             {"FieldMaximum",          [](CS s){return std::make_unique<FieldMaximum>(s);}},
             {"FieldReduction",        [](CS s){return std::make_unique<FieldReduction>(s);}},
+            {"FieldSlices",           [](CS s){return std::make_unique<FieldSlices>(s);}},
             {"RhoMaximum",            [](CS s){return std::make_unique<RhoMaximum>(s);}},
             {"BeamRelevant",          [](CS s){return std::make_unique<BeamRelevant>(s);}},
             {"LoadBalanceCosts",      [](CS s){return std::make_unique<LoadBalanceCosts>(s);}},
             {"LoadBalanceEfficiency", [](CS s){return std::make_unique<LoadBalanceEfficiency>(s);}},
             {"ParticleHistogram",     [](CS s){return std::make_unique<ParticleHistogram>(s);}},
+            {"ParticleHistogramND",   [](CS s){return std::make_unique<ParticleHistogramND>(s);}},
             {"ParticleNumber",        [](CS s){return std::make_unique<ParticleNumber>(s);}},
-            {"ParticleExtrema",       [](CS s){return std::make_unique<ParticleExtrema>(s);}}
+            {"ParticleExtrema",       [](CS s){return std::make_unique<ParticleExtrema>(s);}},
+            {"StepTiming",            [](CS s){return std::make_unique<StepTiming>(s);}},
+            {"MemoryUsage",           [](CS s){return std::make_unique<MemoryUsage>(s);}}
         };
     // loop over all reduced diags and fill m_multi_rd with requested reduced diags
     std::transform(m_rd_names.begin(), m_rd_names.end(), std::back_inserter(m_multi_rd),
@@ -81,6 +90,14 @@ MultiReducedDiags::MultiReducedDiags ()
 // call functions to compute diags
 void MultiReducedDiags::ComputeDiags (int step)
 {
+    // particles have moved since the last call: the particle moments shared
+    // by the reduced diags of this step are computed again on first use
+    ParticleMoments::Invalidate();
+
+    // the memory usage is sampled at every step, in order to record the
+    // high-water marks, once for all the MemoryUsage reduced diags
+    MemoryUsage::Sample();
+
     // loop over all reduced diags
     for (int i_rd = 0; i_rd < static_cast<int>(m_rd_names.size()); ++i_rd)
     {
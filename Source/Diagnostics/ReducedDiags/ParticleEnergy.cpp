@@ -7,22 +7,17 @@
 
 #include "ParticleEnergy.H"
 
+#include "Diagnostics/ReducedDiags/ParticleMoments.H"
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "Particles/MultiParticleContainer.H"
-#include "Particles/SpeciesPhysicalProperties.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/IntervalsParser.H"
-#include "Utils/WarpXConst.H"
 #include "WarpX.H"
 
-#include <AMReX_GpuQualifiers.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_ParallelDescriptor.H>
-#include <AMReX_ParticleReduce.H>
 #include <AMReX_Particles.H>
 #include <AMReX_REAL.H>
-#include <AMReX_Reduce.H>
-#include <AMReX_Tuple.H>
 #include <AMReX_Vector.H>
 
 #include <algorithm>
@@ -100,10 +95,6 @@ void ParticleEnergy::ComputeDiags (int step)
     // Get number of species
     const int nSpecies = mypc.nSpecies();
 
-    // Some useful constants
-    amrex::Real c2 = PhysConst::c * PhysConst::c;
-    amrex::Real c4 = c2 * c2;
-
     // Some useful offsets to fill m_data below
     int offset_total_species, offset_mean_species, offset_mean_all;
 
@@ -112,65 +103,13 @@ void ParticleEnergy::ComputeDiags (int step)
     // Loop over species
     for (int i_s = 0; i_s < nSpecies; ++i_s)
     {
-        // Get WarpXParticleContainer class object
-        const auto & myspc = mypc.GetParticleContainer(i_s);
-
-        // Get mass (used only for particles other than photons, see below)
-        amrex::Real m = myspc.getMass();
-        amrex::Real m2 = m * m;
-
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-
-        amrex::Real Etot = 0.0_rt;
-        amrex::Real Ws   = 0.0_rt;
-
-        // Use amrex::ParticleReduce to compute the sum of energies and weights of all particles
-        // held by the current MPI rank for this species (loop over all boxes held by this MPI rank):
-        // the result r is the tuple (Etot, Ws)
-        amrex::ReduceOps<ReduceOpSum, ReduceOpSum> reduce_ops;
-        if(myspc.AmIA<PhysicalSpecies::photon>())
-        {
-            // Photons have zero mass, but ux, uy and uz are calculated assuming a mass equal to the
-            // electron mass. Hence, photons need a special treatment to calculate the total energy.
-            constexpr auto me_c = PhysConst::m_e * PhysConst::c;
-            auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real uy = p.rdata(PIdx::uy);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-                    const amrex::Real us = ux*ux + uy*uy + uz*uz;
-                    return {w*me_c*std::sqrt(us), w};
-                },
-                reduce_ops);
-
-            Etot = amrex::get<0>(r);
-            Ws   = amrex::get<1>(r);
-        }
-        else // particle other than photons
-        {
-            auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real>>(
-                myspc,
-                [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real>
-                {
-                    const amrex::Real w  = p.rdata(PIdx::w);
-                    const amrex::Real ux = p.rdata(PIdx::ux);
-                    const amrex::Real uy = p.rdata(PIdx::uy);
-                    const amrex::Real uz = p.rdata(PIdx::uz);
-                    const amrex::Real us = ux*ux + uy*uy + uz*uz;
-                    return {w*(std::sqrt(us*m2*c2 + m2*c4) - m*c2), w};
-                },
-                reduce_ops);
-
-            Etot = amrex::get<0>(r);
-            Ws   = amrex::get<1>(r);
-        }
-
-        // Reduced sum over MPI ranks
-        ParallelDescriptor::ReduceRealSum(Etot, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Ws  , ParallelDescriptor::IOProcessorNumber());
+        // The sums of energies and weights of all particles of this species are computed
+        // by the reduction engine shared by the particle reduced diagnostics.
+        // Photons are treated as a special case there, since they have zero mass
+        // but ux, uy and uz are calculated assuming a mass equal to the electron mass.
+        ParticleMomentsData const & moments = ParticleMoments::Get(i_s);
+        const amrex::Real Etot = moments.energy_sum;
+        const amrex::Real Ws   = moments.w_sum;
 
         // Accumulate sum of weights over all species (must come after MPI reduction of Ws)
         Wtot += Ws;
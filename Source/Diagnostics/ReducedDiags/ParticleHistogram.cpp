@@ -12,6 +12,7 @@
 #include "Particles/Pusher/GetAndSetPosition.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/IntervalsParser.H"
+#include "Utils/ParserJIT.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXUtil.H"
 #include "WarpX.H"
@@ -40,15 +41,6 @@
 
 using namespace amrex;
 
-struct NormalizationType {
-    enum {
-        no_normalization = 0,
-        unity_particle_weight,
-        max_to_unity,
-        area_to_unity
-    };
-};
-
 // constructor
 ParticleHistogram::ParticleHistogram (std::string rd_name)
 : ReducedDiags{rd_name}
@@ -66,11 +58,11 @@ ParticleHistogram::ParticleHistogram (std::string rd_name)
     m_bin_size = (m_bin_max - m_bin_min) / m_bin_num;
 
     // read histogram function
-    std::string function_string = "";
     Store_parserString(pp_rd_name,"histogram_function(t,x,y,z,ux,uy,uz)",
-                       function_string);
+                       m_function_string);
     m_parser = std::make_unique<amrex::Parser>(
-        makeParser(function_string,{"t","x","y","z","ux","uy","uz"}));
+        makeParser(m_function_string,{"t","x","y","z","ux","uy","uz"}));
+    ParserJIT::compile(m_function_string,{"t","x","y","z","ux","uy","uz"});
 
     // read normalization type
     std::string norm_string = "default";
@@ -109,10 +101,10 @@ ParticleHistogram::ParticleHistogram (std::string rd_name)
     std::string buf;
     m_do_parser_filter = pp_rd_name.query("filter_function(t,x,y,z,ux,uy,uz)", buf);
     if (m_do_parser_filter) {
-        std::string filter_string = "";
-        Store_parserString(pp_rd_name,"filter_function(t,x,y,z,ux,uy,uz)", filter_string);
+        Store_parserString(pp_rd_name,"filter_function(t,x,y,z,ux,uy,uz)", m_filter_string);
         m_parser_filter = std::make_unique<amrex::Parser>(
-                                     makeParser(filter_string,{"t","x","y","z","ux","uy","uz"}));
+                                     makeParser(m_filter_string,{"t","x","y","z","ux","uy","uz"}));
+        ParserJIT::compile(m_filter_string,{"t","x","y","z","ux","uy","uz"});
     }
 
     // resize data array
@@ -165,10 +157,12 @@ void ParticleHistogram::ComputeDiags (int step)
     auto & myspc = mypc.GetParticleContainer(m_selected_species_id);
 
     // get parser
-    auto fun_partparser = compileParser<m_nvars>(m_parser.get());
+    auto fun_partparser = compileJITParser<m_nvars>(m_parser.get(), m_function_string,
+                                                    {"t","x","y","z","ux","uy","uz"});
 
     // get filter parser
-    auto fun_filterparser = compileParser<m_nvars>(m_parser_filter.get());
+    auto fun_filterparser = compileJITParser<m_nvars>(m_parser_filter.get(), m_filter_string,
+                                                      {"t","x","y","z","ux","uy","uz"});
 
     // declare local variables
     auto const num_bins = m_bin_num;
@@ -0,0 +1,420 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "ParticleHistogramND.H"
+
+#include "Diagnostics/ReducedDiags/ParticleHistogram.H"
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/IntervalsParser.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXUtil.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Array.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_Config.H>
+#include <AMReX_Extension.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuMemory.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_Math.H>
+#include <AMReX_ParIter.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+
+#ifdef AMREX_USE_OMP
+#   include <omp.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace amrex;
+
+// constructor
+ParticleHistogramND::ParticleHistogramND (std::string rd_name)
+: ReducedDiags{rd_name}
+{
+    ParmParse pp_rd_name(rd_name);
+
+    // read species
+    std::string selected_species_name;
+    pp_rd_name.get("species",selected_species_name);
+
+    // read axes
+    pp_rd_name.getarr("axes", m_axes);
+    int const naxes = static_cast<int>(m_axes.size());
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(naxes >= 1 && naxes <= m_max_axes,
+        "ParticleHistogramND: the number of axes must be between 1 and 6");
+
+    // read the histogram function and the bin parameters of each axis
+    for (auto const & axis : m_axes)
+    {
+        ParmParse pp_axis(rd_name + "." + axis);
+
+        int bin_num;
+        Real bin_min, bin_max;
+        pp_axis.get("bin_number", bin_num);
+        getWithParser(pp_axis, "bin_max", bin_max);
+        getWithParser(pp_axis, "bin_min", bin_min);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(bin_num > 0 && bin_max > bin_min,
+            "ParticleHistogramND: invalid bins along axis " + axis);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            m_num_bins_total <= std::numeric_limits<int>::max() / bin_num,
+            "ParticleHistogramND: too many bins");
+        m_bin_num.push_back(bin_num);
+        m_bin_min.push_back(bin_min);
+        m_bin_size.push_back((bin_max - bin_min) / bin_num);
+        m_num_bins_total *= bin_num;
+
+        std::string function_string = "";
+        Store_parserString(pp_axis,"function(t,x,y,z,ux,uy,uz)", function_string);
+        m_parsers.push_back(std::make_unique<amrex::Parser>(
+            makeParser(function_string,{"t","x","y","z","ux","uy","uz"})));
+    }
+
+    // read normalization type
+    std::string norm_string = "default";
+    pp_rd_name.query("normalization",norm_string);
+
+    // set normalization type
+    if ( norm_string == "default" ) {
+        m_norm = NormalizationType::no_normalization;
+    } else if ( norm_string == "unity_particle_weight" ) {
+        m_norm = NormalizationType::unity_particle_weight;
+    } else if ( norm_string == "max_to_unity" ) {
+        m_norm = NormalizationType::max_to_unity;
+    } else if ( norm_string == "area_to_unity" ) {
+        m_norm = NormalizationType::area_to_unity;
+    } else {
+        Abort("Unknown ParticleHistogramND normalization type.");
+    }
+
+    // get MultiParticleContainer class object
+    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+    // get species names (std::vector<std::string>)
+    auto const species_names = mypc.GetSpeciesNames();
+    // select species
+    for ( int i = 0; i < mypc.nSpecies(); ++i )
+    {
+        if ( selected_species_name == species_names[i] ){
+            m_selected_species_id = i;
+        }
+    }
+    // if m_selected_species_id is not modified
+    if ( m_selected_species_id == -1 ){
+        Abort("Unknown species for ParticleHistogramND reduced diagnostic.");
+    }
+
+    // Read optional filter
+    std::string buf;
+    m_do_parser_filter = pp_rd_name.query("filter_function(t,x,y,z,ux,uy,uz)", buf);
+    if (m_do_parser_filter) {
+        std::string filter_string = "";
+        Store_parserString(pp_rd_name,"filter_function(t,x,y,z,ux,uy,uz)", filter_string);
+        m_parser_filter = std::make_unique<amrex::Parser>(
+                                     makeParser(filter_string,{"t","x","y","z","ux","uy","uz"}));
+    }
+
+    // resize data array
+    m_data.resize(m_num_bins_total,0.0_rt);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        if ( m_IsNotRestart )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row: one column per bin, the bins being ordered with the
+            // last axis varying fastest (their centers are in the axes file)
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (int ibin = 0; ibin < m_num_bins_total; ++ibin)
+            {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]bin_" << ibin << "()";
+            }
+            ofs << std::endl;
+            // close file
+            ofs.close();
+
+            // write the bin centers of each axis, once, in the axes file
+            std::ofstream ofs_axes{m_path + m_rd_name + "_axes.txt", std::ofstream::out};
+            ofs_axes << std::setprecision(14) << std::scientific;
+            ofs_axes << "# bin centers along each axis of " << m_rd_name
+                     << ", whose bins vary fastest along the last axis" << std::endl;
+            for (int iaxis = 0; iaxis < naxes; ++iaxis)
+            {
+                ofs_axes << m_axes[iaxis];
+                for (int i = 0; i < m_bin_num[iaxis]; ++i)
+                {
+                    ofs_axes << m_sep << m_bin_min[iaxis] + m_bin_size[iaxis]*(Real(i)+0.5_rt);
+                }
+                ofs_axes << std::endl;
+            }
+            ofs_axes.close();
+        }
+    }
+}
+// end constructor
+
+// function that computes the histogram
+void ParticleHistogramND::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) return;
+
+    // get a reference to WarpX instance
+    auto & warpx = WarpX::GetInstance();
+
+    // get time at level 0
+    auto const t = warpx.gett_new(0);
+
+    // get MultiParticleContainer class object
+    const auto & mypc = warpx.GetPartContainer();
+
+    // get WarpXParticleContainer class object
+    auto & myspc = mypc.GetParticleContainer(m_selected_species_id);
+
+    // get parsers and bin parameters of each axis
+    int const naxes = static_cast<int>(m_axes.size());
+    GpuArray<ParserExecutor<m_nvars>, m_max_axes> fun_partparsers;
+    GpuArray<int, m_max_axes> bin_num;
+    GpuArray<Real, m_max_axes> bin_min;
+    GpuArray<Real, m_max_axes> bin_size;
+    for (int iaxis = 0; iaxis < naxes; ++iaxis)
+    {
+        fun_partparsers[iaxis] = compileParser<m_nvars>(m_parsers[iaxis].get());
+        bin_num[iaxis] = m_bin_num[iaxis];
+        bin_min[iaxis] = m_bin_min[iaxis];
+        bin_size[iaxis] = m_bin_size[iaxis];
+    }
+
+    // get filter parser
+    auto fun_filterparser = compileParser<m_nvars>(m_parser_filter.get());
+
+    // declare local variables
+    int const num_bins = m_num_bins_total;
+    const bool is_unity_particle_weight =
+        (m_norm == NormalizationType::unity_particle_weight) ? true : false;
+
+    bool const do_parser_filter = m_do_parser_filter;
+
+    int const nlevs = std::max(0, myspc.finestLevel()+1);
+
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+    // on GPU, each block of threads accumulates its own histogram in shared memory,
+    // if it fits, and adds it to the histogram of this rank once at the end
+    std::size_t const shared_mem_bytes = std::size_t(num_bins)*sizeof(amrex::Real);
+    bool const use_shared_memory = (shared_mem_bytes <= amrex::Gpu::Device::sharedMemPerBlock());
+#else
+    bool const use_shared_memory = false;
+#endif
+
+    // number of private histograms
+#if defined(AMREX_USE_GPU)
+    // otherwise, one per tile in global memory, within a memory budget
+    int ntiles = 0;
+    for (int lev = 0; lev < nlevs; ++lev) {
+        for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti) { ++ntiles; }
+    }
+    int const nprivate = use_shared_memory ? 1 :
+        std::max(1, std::min(ntiles, m_max_private_bins / num_bins));
+    bool const is_shared = true;
+#elif defined(AMREX_USE_OMP)
+    // one per thread, within the same memory budget; otherwise, the threads share
+    // the private histograms and add to them with atomics
+    int const nthreads = omp_get_max_threads();
+    int const nprivate = std::max(1, std::min(nthreads, m_max_private_bins / num_bins));
+    bool const is_shared = (nprivate < nthreads);
+#else
+    int const nprivate = 1;
+    bool const is_shared = false;
+#endif
+    amrex::ignore_unused(use_shared_memory, is_shared);
+
+    amrex::Gpu::DeviceVector< amrex::Real > d_private( std::size_t(nprivate)*num_bins, 0.0_rt );
+    amrex::Real* const AMREX_RESTRICT dptr_private = d_private.dataPtr();
+
+#if defined(AMREX_USE_GPU)
+    int itile = 0;
+#endif
+    for (int lev = 0; lev < nlevs; ++lev) {
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        {
+            for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+            {
+#if defined(AMREX_USE_GPU)
+                int const iprivate = (itile++) % nprivate;
+#elif defined(AMREX_USE_OMP)
+                int const iprivate = omp_get_thread_num() % nprivate;
+#else
+                int const iprivate = 0;
+#endif
+                amrex::Real* const AMREX_RESTRICT hist = dptr_private + std::size_t(iprivate)*num_bins;
+
+                auto const GetPosition = GetParticlePosition(pti);
+
+                auto & attribs = pti.GetAttribs();
+                Real* const AMREX_RESTRICT d_w = attribs[PIdx::w].dataPtr();
+                Real* const AMREX_RESTRICT d_ux = attribs[PIdx::ux].dataPtr();
+                Real* const AMREX_RESTRICT d_uy = attribs[PIdx::uy].dataPtr();
+                Real* const AMREX_RESTRICT d_uz = attribs[PIdx::uz].dataPtr();
+
+                long const np = pti.numParticles();
+
+                // bin of particle i, with the last axis varying fastest, and its value;
+                // returns -1 if the particle is filtered out or out of range
+                auto const get_bin = [=] AMREX_GPU_HOST_DEVICE (long i, amrex::Real& val) -> int
+                {
+                    amrex::ParticleReal x, y, z;
+                    GetPosition(i, x, y, z);
+                    auto const w  = d_w[i];
+                    auto const ux = d_ux[i] / PhysConst::c;
+                    auto const uy = d_uy[i] / PhysConst::c;
+                    auto const uz = d_uz[i] / PhysConst::c;
+
+                    // don't count a particle if it is filtered out
+                    if (do_parser_filter)
+                        if (!fun_filterparser(t, x, y, z, ux, uy, uz))
+                            return -1;
+
+                    int bin = 0;
+                    for (int iaxis = 0; iaxis < naxes; ++iaxis)
+                    {
+                        auto const f = fun_partparsers[iaxis](t, x, y, z, ux, uy, uz);
+                        int const b = int(Math::floor((f-bin_min[iaxis])/bin_size[iaxis]));
+                        if ( b<0 || b>=bin_num[iaxis] ) return -1; // discard if out-of-range
+                        bin = bin*bin_num[iaxis] + b;
+                    }
+                    val = is_unity_particle_weight ? 1.0_rt : w;
+                    return bin;
+                };
+
+#if defined(AMREX_USE_CUDA) || defined(AMREX_USE_HIP)
+                if (use_shared_memory)
+                {
+                    if (np == 0) continue;
+                    constexpr int nthreads = AMREX_GPU_MAX_THREADS;
+                    int const nblocks = static_cast<int>(std::min(
+                        (np + nthreads - 1) / nthreads,
+                        static_cast<long>(amrex::Gpu::Device::maxBlocksPerLaunch())));
+                    amrex::launch<nthreads>(nblocks, shared_mem_bytes, amrex::Gpu::gpuStream(),
+                    [=] AMREX_GPU_DEVICE () noexcept
+                    {
+                        amrex::Gpu::SharedMemory<amrex::Real> gsm;
+                        amrex::Real* const block_hist = gsm.dataPtr();
+                        for (int ibin = threadIdx.x; ibin < num_bins; ibin += blockDim.x) {
+                            block_hist[ibin] = 0.0_rt;
+                        }
+                        __syncthreads();
+                        for (long i = long(blockIdx.x)*blockDim.x + threadIdx.x; i < np;
+                             i += long(gridDim.x)*blockDim.x)
+                        {
+                            amrex::Real val;
+                            int const bin = get_bin(i, val);
+                            if (bin >= 0) amrex::Gpu::Atomic::AddNoRet(&block_hist[bin], val);
+                        }
+                        __syncthreads();
+                        // merge once per block
+                        for (int ibin = threadIdx.x; ibin < num_bins; ibin += blockDim.x) {
+                            if (block_hist[ibin] != 0.0_rt) {
+                                amrex::Gpu::Atomic::AddNoRet(&hist[ibin], block_hist[ibin]);
+                            }
+                        }
+                    });
+                    continue;
+                }
+#endif
+
+                amrex::ParallelFor(np,
+                   [=] AMREX_GPU_DEVICE(long i)
+                {
+                    amrex::Real val;
+                    int const bin = get_bin(i, val);
+                    if (bin < 0) return;
+
+                    // add particle to the private histogram: on CPU, each thread
+                    // owns its histogram unless they exceed the memory budget,
+                    // while on GPU, the tiles may share one
+#if defined(AMREX_USE_GPU)
+                    amrex::Gpu::Atomic::AddNoRet(&hist[bin], val);
+#else
+                    if (is_shared) {
+                        amrex::HostDevice::Atomic::Add(&hist[bin], val);
+                    } else {
+                        hist[bin] += val;
+                    }
+#endif
+                });
+            }
+        }
+    }
+
+    // merge the private histograms
+    amrex::Gpu::DeviceVector< amrex::Real > d_data( m_data.size(), 0.0_rt );
+    amrex::Real* const AMREX_RESTRICT dptr_data = d_data.dataPtr();
+    amrex::ParallelFor(num_bins,
+        [=] AMREX_GPU_DEVICE(int ibin)
+    {
+        amrex::Real sum = 0.0_rt;
+        for (int iprivate = 0; iprivate < nprivate; ++iprivate) {
+            sum += dptr_private[std::size_t(iprivate)*num_bins + ibin];
+        }
+        dptr_data[ibin] = sum;
+    });
+
+    // blocking copy from device to host
+    amrex::Gpu::copy(amrex::Gpu::deviceToHost,
+        d_data.begin(), d_data.end(), m_data.begin());
+
+    // reduced sum over mpi ranks
+    ParallelDescriptor::ReduceRealSum
+        (m_data.data(), m_data.size(), ParallelDescriptor::IOProcessorNumber());
+
+    // normalize the maximum value to be one
+    if ( m_norm == NormalizationType::max_to_unity )
+    {
+        Real const f_max = *std::max_element(m_data.begin(), m_data.end());
+        if ( f_max > std::numeric_limits<Real>::min() ) {
+            for (auto & f : m_data) f /= f_max;
+        }
+        return;
+    }
+
+    // normalize the integral over all axes to be one
+    if ( m_norm == NormalizationType::area_to_unity )
+    {
+        Real bin_volume = 1.0_rt;
+        for (int iaxis = 0; iaxis < naxes; ++iaxis) bin_volume *= m_bin_size[iaxis];
+        Real f_area = 0.0_rt;
+        for (auto const f : m_data) f_area += f * bin_volume;
+        if ( f_area > std::numeric_limits<Real>::min() ) {
+            for (auto & f : m_data) f /= f_area;
+        }
+        return;
+    }
+}
+// end void ParticleHistogramND::ComputeDiags
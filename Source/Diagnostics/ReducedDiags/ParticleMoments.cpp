@@ -0,0 +1,235 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "ParticleMoments.H"
+
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/SpeciesPhysicalProperties.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/WarpXConst.H"
+#include "WarpX.H"
+
+#include <AMReX_Array.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParticleReduce.H>
+#include <AMReX_Particles.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
+#include <AMReX_Tuple.H>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+using namespace amrex;
+
+std::vector<ParticleMomentsData> ParticleMoments::m_moments;
+std::vector<bool> ParticleMoments::m_is_valid;
+
+namespace
+{
+    using PType = typename WarpXParticleContainer::SuperParticleType;
+
+    /** Number of sums: weight, energy, one first and one second moment per attribute,
+     *  and the three position-momentum correlations */
+    constexpr int nsums = 2 + 2*MomentIdx::nattribs + 3;
+
+    using MomentsReduceOps = amrex::ReduceOps<
+        ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+        ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+        ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+        ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum>;
+    using MomentsReduceData = amrex::ReduceData<
+        Real, Real, Real, Real, Real,
+        Real, Real, Real, Real, Real,
+        Real, Real, Real, Real, Real,
+        Real, Real, Real, Real>;
+
+    using MeansReduceOps = amrex::ReduceOps<
+        ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum,
+        ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum>;
+    using MeansReduceData = amrex::ReduceData<
+        Real, Real, Real, Real,
+        Real, Real, Real, Real>;
+
+    static_assert(amrex::GpuTupleSize<typename MomentsReduceData::Type>::value == nsums,
+                  "ParticleMoments: wrong number of sums in the reduction tuple");
+
+    /** Copy the elements of a GpuTuple of Reals to an array */
+    template <std::size_t I = 0, typename... Ts>
+    std::enable_if_t<I == sizeof...(Ts)>
+    TupleToArray (GpuTuple<Ts...> const&, Real*) {}
+
+    template <std::size_t I = 0, typename... Ts>
+    std::enable_if_t<I < sizeof...(Ts)>
+    TupleToArray (GpuTuple<Ts...> const& t, Real* a)
+    {
+        a[I] = amrex::get<I>(t);
+        TupleToArray<I+1>(t, a);
+    }
+
+    /** Quantities of MomentIdx for one particle */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    GpuArray<Real, MomentIdx::nattribs>
+    getAttribs (const PType& p, Real inv_c2) noexcept
+    {
+        GpuArray<Real, MomentIdx::nattribs> a;
+#if (defined WARPX_DIM_3D)
+        a[MomentIdx::x] = p.pos(0);
+        a[MomentIdx::y] = p.pos(1);
+        a[MomentIdx::z] = p.pos(2);
+#elif (defined WARPX_DIM_RZ)
+        a[MomentIdx::x] = p.pos(0)*std::cos(p.rdata(PIdx::theta));
+        a[MomentIdx::y] = p.pos(0)*std::sin(p.rdata(PIdx::theta));
+        a[MomentIdx::z] = p.pos(1);
+#else
+        a[MomentIdx::x] = p.pos(0);
+        a[MomentIdx::y] = 0.0_rt;
+        a[MomentIdx::z] = p.pos(1);
+#endif
+        a[MomentIdx::ux] = p.rdata(PIdx::ux);
+        a[MomentIdx::uy] = p.rdata(PIdx::uy);
+        a[MomentIdx::uz] = p.rdata(PIdx::uz);
+        const Real us = a[MomentIdx::ux]*a[MomentIdx::ux]
+                      + a[MomentIdx::uy]*a[MomentIdx::uy]
+                      + a[MomentIdx::uz]*a[MomentIdx::uz];
+        a[MomentIdx::gamma] = std::sqrt(1.0_rt + us*inv_c2);
+        return a;
+    }
+}
+
+ParticleMomentsData const&
+ParticleMoments::Get (int i_s)
+{
+    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+    const auto nSpecies = static_cast<std::size_t>(mypc.nSpecies());
+    if (m_moments.size() != nSpecies) {
+        m_moments.resize(nSpecies);
+        m_is_valid.assign(nSpecies, false);
+    }
+
+    if (!m_is_valid[i_s])
+    {
+        const auto & myspc = mypc.GetParticleContainer(i_s);
+        // The moments are centred on the current means, computed in a first cheap
+        // traversal, so that the sums of squares do not cancel when the beam moves
+        m_moments[i_s] = Compute(myspc, ComputeMeans(myspc));
+        m_is_valid[i_s] = true;
+    }
+    return m_moments[i_s];
+}
+
+void
+ParticleMoments::Invalidate ()
+{
+    std::fill(m_is_valid.begin(), m_is_valid.end(), false);
+}
+
+std::array<Real, MomentIdx::nattribs>
+ParticleMoments::ComputeMeans (WarpXParticleContainer const& pc)
+{
+    constexpr Real inv_c2 = 1.0_rt / (PhysConst::c * PhysConst::c);
+
+    MeansReduceOps reduce_ops;
+    const auto r = amrex::ParticleReduce<MeansReduceData>(
+        pc,
+        [=] AMREX_GPU_DEVICE (const PType& p) noexcept -> typename MeansReduceData::Type
+        {
+            const Real w = p.rdata(PIdx::w);
+            const auto a = getAttribs(p, inv_c2);
+            return {w,
+                    w*a[MomentIdx::x],  w*a[MomentIdx::y],  w*a[MomentIdx::z],
+                    w*a[MomentIdx::ux], w*a[MomentIdx::uy], w*a[MomentIdx::uz],
+                    w*a[MomentIdx::gamma]};
+        },
+        reduce_ops);
+
+    Real sums[1 + MomentIdx::nattribs];
+    TupleToArray(r, sums);
+    ParallelDescriptor::ReduceRealSum(sums, 1 + MomentIdx::nattribs);
+
+    std::array<Real, MomentIdx::nattribs> means {};
+    if (sums[0] > std::numeric_limits<Real>::min()) {
+        for (int k = 0; k < MomentIdx::nattribs; ++k) means[k] = sums[1+k] / sums[0];
+    }
+    return means;
+}
+
+ParticleMomentsData
+ParticleMoments::Compute (WarpXParticleContainer const& pc,
+                          std::array<Real, MomentIdx::nattribs> const& shift)
+{
+    constexpr Real c2 = PhysConst::c * PhysConst::c;
+    constexpr Real inv_c2 = 1.0_rt / c2;
+
+    // Photons have zero mass, but ux, uy and uz are calculated assuming a mass equal to the
+    // electron mass. Hence, photons need a special treatment to calculate the energy.
+    const bool is_photon = pc.AmIA<PhysicalSpecies::photon>();
+    const Real m = pc.getMass();
+    constexpr Real me_c = PhysConst::m_e * PhysConst::c;
+
+    GpuArray<Real, MomentIdx::nattribs> s;
+    for (int k = 0; k < MomentIdx::nattribs; ++k) s[k] = shift[k];
+
+    MomentsReduceOps reduce_ops;
+    const auto r = amrex::ParticleReduce<MomentsReduceData>(
+        pc,
+        [=] AMREX_GPU_DEVICE (const PType& p) noexcept -> typename MomentsReduceData::Type
+        {
+            const Real w = p.rdata(PIdx::w);
+            const auto a = getAttribs(p, inv_c2);
+
+            const Real dx  = a[MomentIdx::x]     - s[MomentIdx::x];
+            const Real dy  = a[MomentIdx::y]     - s[MomentIdx::y];
+            const Real dz  = a[MomentIdx::z]     - s[MomentIdx::z];
+            const Real dux = a[MomentIdx::ux]    - s[MomentIdx::ux];
+            const Real duy = a[MomentIdx::uy]    - s[MomentIdx::uy];
+            const Real duz = a[MomentIdx::uz]    - s[MomentIdx::uz];
+            const Real dgm = a[MomentIdx::gamma] - s[MomentIdx::gamma];
+
+            const Real us = a[MomentIdx::ux]*a[MomentIdx::ux]
+                          + a[MomentIdx::uy]*a[MomentIdx::uy]
+                          + a[MomentIdx::uz]*a[MomentIdx::uz];
+            // m*c^2*(gamma-1), written without cancellation for non-relativistic particles
+            const Real energy = is_photon ? me_c*std::sqrt(us)
+                                          : m*us/(a[MomentIdx::gamma] + 1.0_rt);
+
+            return {w, w*energy,
+                    w*dx, w*dy, w*dz, w*dux, w*duy, w*duz, w*dgm,
+                    w*dx*dx, w*dy*dy, w*dz*dz, w*dux*dux, w*duy*duy, w*duz*duz, w*dgm*dgm,
+                    w*dx*dux, w*dy*duy, w*dz*duz};
+        },
+        reduce_ops);
+
+    // A single MPI reduction for all the sums
+    Real sums[nsums];
+    TupleToArray(r, sums);
+    ParallelDescriptor::ReduceRealSum(sums, nsums);
+
+    ParticleMomentsData moments;
+    moments.w_sum = sums[0];
+    moments.energy_sum = sums[1];
+    if (moments.w_sum < std::numeric_limits<Real>::min()) return moments;
+
+    const Real inv_w = 1.0_rt / moments.w_sum;
+    const Real* const first = sums + 2;
+    const Real* const second = first + MomentIdx::nattribs;
+    const Real* const cross = second + MomentIdx::nattribs;
+    for (int k = 0; k < MomentIdx::nattribs; ++k) {
+        const Real d = first[k] * inv_w;
+        moments.mean[k] = shift[k] + d;
+        moments.var[k] = std::max(second[k]*inv_w - d*d, 0.0_rt);
+    }
+    for (int k = 0; k < 3; ++k) {
+        moments.cov[k] = cross[k]*inv_w - (first[k]*inv_w) * (first[MomentIdx::ux+k]*inv_w);
+    }
+    return moments;
+}
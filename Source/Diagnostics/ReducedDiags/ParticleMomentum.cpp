@@ -7,6 +7,7 @@
 
 #include "ParticleMomentum.H"
 
+#include "Diagnostics/ReducedDiags/ParticleMoments.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/SpeciesPhysicalProperties.H"
 #include "Particles/WarpXParticleContainer.H"
@@ -14,14 +15,10 @@
 #include "Utils/WarpXConst.H"
 #include "WarpX.H"
 
-#include <AMReX_GpuQualifiers.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_ParallelDescriptor.H>
-#include <AMReX_ParticleReduce.H>
 #include <AMReX_Particles.H>
 #include <AMReX_REAL.H>
-#include <AMReX_Reduce.H>
-#include <AMReX_Tuple.H>
 #include <AMReX_Vector.H>
 
 #include <algorithm>
@@ -144,34 +141,13 @@ void ParticleMomentum::ComputeDiags (int step)
         // but ux, uy, uz are calculated assuming a mass equal to the electron mass)
         const amrex::Real m = (myspc.AmIA<PhysicalSpecies::photon>()) ? PhysConst::m_e : myspc.getMass();
 
-        using PType = typename WarpXParticleContainer::SuperParticleType;
-
-        // Use amrex::ParticleReduce to compute the sum of the momenta and weights of all particles
-        // held by the current MPI rank for this species (loop over all boxes held by this MPI rank):
-        // the result r is the tuple (Px, Py, Pz, Ws)
-        amrex::ReduceOps<ReduceOpSum, ReduceOpSum, ReduceOpSum, ReduceOpSum> reduce_ops;
-        auto r = amrex::ParticleReduce<amrex::ReduceData<Real, Real, Real, Real>>(
-            myspc,
-            [=] AMREX_GPU_DEVICE(const PType& p) noexcept -> amrex::GpuTuple<Real, Real, Real, Real>
-            {
-                const amrex::Real w  = p.rdata(PIdx::w);
-                const amrex::Real ux = p.rdata(PIdx::ux);
-                const amrex::Real uy = p.rdata(PIdx::uy);
-                const amrex::Real uz = p.rdata(PIdx::uz);
-                return {w*m*ux, w*m*uy, w*m*uz, w};
-            },
-            reduce_ops);
-
-        amrex::Real Px = amrex::get<0>(r);
-        amrex::Real Py = amrex::get<1>(r);
-        amrex::Real Pz = amrex::get<2>(r);
-        amrex::Real Ws = amrex::get<3>(r);
-
-        // Reduced sum over MPI ranks
-        ParallelDescriptor::ReduceRealSum(Px, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Py, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Pz, ParallelDescriptor::IOProcessorNumber());
-        ParallelDescriptor::ReduceRealSum(Ws, ParallelDescriptor::IOProcessorNumber());
+        // The sums of the momenta and weights of all particles of this species are computed
+        // by the reduction engine shared by the particle reduced diagnostics
+        ParticleMomentsData const & moments = ParticleMoments::Get(i_s);
+        const amrex::Real Ws = moments.w_sum;
+        const amrex::Real Px = m * moments.mean[MomentIdx::ux] * Ws;
+        const amrex::Real Py = m * moments.mean[MomentIdx::uy] * Ws;
+        const amrex::Real Pz = m * moments.mean[MomentIdx::uz] * Ws;
 
         // Accumulate sum of weights over all species (must come after MPI reduction of Ws)
         Wtot += Ws;
@@ -7,13 +7,17 @@
 
 #include "ReducedDiags.H"
 
+#include "Utils/WarpXUtil.H"
 #include "WarpX.H"
 
 #include <AMReX.H>
+#include <AMReX_BLassert.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Utility.H>
 
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
 
@@ -31,6 +35,17 @@ ReducedDiags::ReducedDiags (std::string rd_name)
     // read path
     pp_rd_name.query("path", m_path);
 
+    // read output format and buffer size
+    pp_rd_name.query("output_format", m_output_format);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_output_format == "text" || m_output_format == "binary",
+        m_rd_name + ".output_format must be text or binary");
+    if (m_output_format == "binary") m_extension = "bin";
+    pp_rd_name.query("buffer_size", m_buffer_size);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_buffer_size > 0,
+        m_rd_name + ".buffer_size must be positive");
+    queryWithParser(pp_rd_name, "flush_interval", m_flush_interval);
+    m_last_flush_time = amrex::second();
+
     // read extension
     pp_rd_name.query("extension", m_extension);
 
@@ -39,6 +54,7 @@ ReducedDiags::ReducedDiags (std::string rd_name)
     ParmParse pp_amr("amr");
     pp_amr.query("restart", restart_chkfile);
     m_IsNotRestart = restart_chkfile.empty();
+    m_write_binary_preamble = (m_output_format == "binary") && m_IsNotRestart;
 
     if (ParallelDescriptor::IOProcessor())
     {
@@ -64,6 +80,12 @@ ReducedDiags::ReducedDiags (std::string rd_name)
 }
 // end constructor
 
+ReducedDiags::~ReducedDiags ()
+{
+    // write the rows left in the buffer, e.g. when the run stops before max_step
+    if (ParallelDescriptor::IOProcessor()) WriteBuffer();
+}
+
 void ReducedDiags::BackwardCompatibility ()
 {
     amrex::ParmParse pp_rd_name(m_rd_name);
@@ -77,33 +99,89 @@ void ReducedDiags::BackwardCompatibility ()
 // write to file function
 void ReducedDiags::WriteToFile (int step) const
 {
-    // open file
-    std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
-        std::ofstream::out | std::ofstream::app};
+    auto & warpx = WarpX::GetInstance();
 
-    // write step
-    ofs << step+1;
+    // append the current row to the buffer
+    m_buffer_steps.push_back(step+1);
+    m_buffer.push_back(warpx.gett_new(0));
+    m_buffer.insert(m_buffer.end(), m_data.begin(), m_data.end());
 
-    ofs << m_sep;
+    // write the buffer once it is full or old enough, and at the last step
+    if (static_cast<int>(m_buffer_steps.size()) >= m_buffer_size ||
+        amrex::second() - m_last_flush_time >= m_flush_interval ||
+        m_intervals.nextContains(step+1) > warpx.maxStep())
+    {
+        WriteBuffer();
+    }
+}
+// end ReducedDiags::WriteToFile
 
-    // set precision
-    ofs << std::fixed << std::setprecision(14) << std::scientific;
+void ReducedDiags::WriteBuffer () const
+{
+    m_last_flush_time = amrex::second();
+    if (m_buffer_steps.empty()) return;
 
-    // write time
-    ofs << WarpX::GetInstance().gett_new(0);
+    const auto nrows = m_buffer_steps.size();
+    const auto row_size = m_buffer.size() / nrows;
 
-    // loop over data size and write
-    for (int i = 0; i < static_cast<int>(m_data.size()); ++i)
+    if (m_output_format == "binary")
     {
-        ofs << m_sep;
-        ofs << m_data[i];
+        // The file starts with the header row of the text format. It is followed by a
+        // preamble of three 32-bit unsigned integers: an endianness marker (0x01020304
+        // in the byte order of the machine that wrote the file), the version of the
+        // format and the number of columns. Then come the rows (step, time, data),
+        // each value stored as a 64-bit float in the byte order of the marker.
+        std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
+            std::ofstream::out | std::ofstream::app | std::ofstream::binary};
+        if (m_write_binary_preamble)
+        {
+            const std::uint32_t preamble[3] = {0x01020304u, 1u,
+                                               static_cast<std::uint32_t>(row_size+1)};
+            ofs.write(reinterpret_cast<char const*>(preamble), sizeof(preamble));
+            m_write_binary_preamble = false;
+        }
+        std::vector<double> rows;
+        rows.reserve(nrows * (row_size+1));
+        for (std::size_t irow = 0; irow < nrows; ++irow)
+        {
+            rows.push_back(static_cast<double>(m_buffer_steps[irow]));
+            rows.insert(rows.end(), m_buffer.begin() + irow*row_size,
+                                    m_buffer.begin() + (irow+1)*row_size);
+        }
+        ofs.write(reinterpret_cast<char const*>(rows.data()),
+                  static_cast<std::streamsize>(rows.size() * sizeof(double)));
+        ofs.close();
     }
-    // end loop over data size
+    else
+    {
+        // open file
+        std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
+            std::ofstream::out | std::ofstream::app};
+
+        // set precision
+        ofs << std::fixed << std::setprecision(14) << std::scientific;
 
-    // end line
-    ofs << std::endl;
+        for (std::size_t irow = 0; irow < nrows; ++irow)
+        {
+            // write step
+            ofs << m_buffer_steps[irow];
+
+            // write time and data
+            for (std::size_t i = 0; i < row_size; ++i)
+            {
+                ofs << m_sep;
+                ofs << m_buffer[irow*row_size + i];
+            }
+
+            // end line
+            ofs << "\n";
+        }
 
-    // close file
-    ofs.close();
+        // close file
+        ofs.close();
+    }
+
+    m_buffer_steps.clear();
+    m_buffer.clear();
 }
-// end ReducedDiags::WriteToFile
+// end ReducedDiags::WriteBuffer
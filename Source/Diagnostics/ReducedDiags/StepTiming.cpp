@@ -0,0 +1,165 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "StepTiming.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/IntervalsParser.H"
+#include "Utils/StepTimers.H"
+#include "WarpX.H"
+
+#include <AMReX_BoxArray.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
+
+#include <ostream>
+#include <vector>
+
+using namespace amrex;
+
+// constructor
+StepTiming::StepTiming (std::string rd_name)
+    : ReducedDiags{rd_name}
+{
+    // do not synchronize the device at each phase transition by default,
+    // as this changes the timings that are measured
+    int synchronize = 0;
+    ParmParse pp_rd_name(rd_name);
+    pp_rd_name.query("synchronize", synchronize);
+    StepTimers::Enable(synchronize);
+
+    // resize data array: mean, min and max of each phase, of the remaining
+    // time and of the total time, and the two throughputs
+    m_data.resize(3*(StepTimers::NumPhases+2) + 2, 0.0_rt);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        if ( m_IsNotRestart )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+
+            // write header row
+            std::vector<std::string> names;
+            for (int i = 0; i < StepTimers::NumPhases; ++i) {
+                names.push_back(StepTimers::Name(i));
+            }
+            names.push_back("other");
+            names.push_back("total");
+
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (const auto& name : names)
+            {
+                for (const auto& stat : {"_mean", "_min", "_max"})
+                {
+                    ofs << m_sep;
+                    ofs << "[" << c++ << "]" << name << stat << "(s)";
+                }
+            }
+            ofs << m_sep;
+            ofs << "[" << c++ << "]particle_pushes_per_s()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]cell_updates_per_s()";
+            ofs << std::endl;
+
+            // close file
+            ofs.close();
+        }
+    }
+}
+
+// compute the time per step of each phase
+void StepTiming::ComputeDiags (int step)
+{
+    // count the steps since the last output
+    ++m_nsteps;
+
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    const double now = amrex::second();
+    const auto phase_times = StepTimers::PhaseTimes();
+
+    // the timers were reset by WarpX::Evolve since the last output
+    if (StepTimers::Epoch() != m_epoch)
+    {
+        m_epoch = StepTimers::Epoch();
+        m_last_time = StepTimers::StartTime();
+        m_last_phase_times.fill(0.);
+    }
+
+    // time per step of each phase on this rank
+    constexpr int nvalues = StepTimers::NumPhases + 2;
+    const int nsteps = (m_nsteps > 0) ? m_nsteps : 1;
+    Real tmax[nvalues], tmin[nvalues], tsum[nvalues];
+    Real phases_total = 0._rt;
+    for (int i = 0; i < StepTimers::NumPhases; ++i)
+    {
+        tmax[i] = static_cast<Real>((phase_times[i] - m_last_phase_times[i]) / nsteps);
+        phases_total += tmax[i];
+    }
+    const Real total = static_cast<Real>((now - m_last_time) / nsteps);
+    tmax[StepTimers::NumPhases] = total - phases_total;
+    tmax[StepTimers::NumPhases+1] = total;
+    for (int i = 0; i < nvalues; ++i)
+    {
+        tmin[i] = tmax[i];
+        tsum[i] = tmax[i];
+    }
+
+    // reduce over the MPI ranks
+    ParallelDescriptor::ReduceRealMax(tmax, nvalues);
+    ParallelDescriptor::ReduceRealMin(tmin, nvalues);
+    ParallelDescriptor::ReduceRealSum(tsum, nvalues);
+
+    const Real nprocs = static_cast<Real>(ParallelDescriptor::NProcs());
+    for (int i = 0; i < nvalues; ++i)
+    {
+        m_data[3*i  ] = tsum[i] / nprocs;
+        m_data[3*i+1] = tmin[i];
+        m_data[3*i+2] = tmax[i];
+    }
+
+    // get a reference to WarpX instance
+    auto & warpx = WarpX::GetInstance();
+
+    // current number of macroparticles and of cells, as the throughput is
+    // limited by the slowest rank
+    const auto & mypc = warpx.GetPartContainer();
+    Real nparticles = 0._rt;
+    for (int i_s = 0; i_s < mypc.nSpecies(); ++i_s)
+    {
+        nparticles += static_cast<Real>(mypc.GetParticleContainer(i_s).TotalNumberOfParticles());
+    }
+    Real ncells = 0._rt;
+    for (int lev = 0; lev <= warpx.finestLevel(); ++lev)
+    {
+        ncells += static_cast<Real>(warpx.boxArray(lev).numPts());
+    }
+
+    const Real push_time = tmax[StepTimers::PushDeposit];
+    const Real field_time = tmax[StepTimers::FieldSolve];
+    m_data[3*nvalues  ] = (push_time > 0._rt) ? nparticles / push_time : 0._rt;
+    m_data[3*nvalues+1] = (field_time > 0._rt) ? ncells / field_time : 0._rt;
+
+    /* m_data now contains up-to-date values for:
+     *  [mean, min and max time per step of each phase,
+     *   of the time outside of the phases and of the whole step,
+     *   particle pushes per second, cell updates per second] */
+
+    // reset for the next output
+    m_nsteps = 0;
+    m_last_time = now;
+    m_last_phase_times = phase_times;
+}
@@ -14,12 +14,15 @@
 #include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_Dim3.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
 #include <AMReX_IndexType.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
@@ -29,9 +32,11 @@
 #include <AMReX_REAL.H>
 #include <AMReX_RealBox.H>
 #include <AMReX_SPACE.H>
+#include <AMReX_Vector.H>
 
 #include <cmath>
 #include <memory>
+#include <utility>
 
 using namespace amrex;
 
@@ -502,3 +507,108 @@ InterpolateLo(const Box& bx, FArrayBox &fabox, IntVect slice_lo,
     }
 
 }
+
+Vector<std::unique_ptr<MultiFab>>
+ExtractSlices (const MultiFab& mf, const Geometry& geom,
+               const Vector<SlicePlane>& planes, int scomp, int ncomp)
+{
+    const IndexType ixtype = mf.ixType();
+    const Box domain = amrex::convert(geom.Domain(), ixtype);
+    const BoxArray& ba = mf.boxArray();
+    const DistributionMapping& dm = mf.DistributionMap();
+    const int nplanes = planes.size();
+    if (nplanes == 0) return {};
+
+    // Layer of points at or below each plane, and interpolation weight of the layer above
+    Vector<int> layer(nplanes);
+    Vector<Real> weight(nplanes);
+
+    // Pieces of the boxes of mf covering the layers around all the planes.
+    // The pieces of plane p are [plane_begin[p], plane_begin[p+1]).
+    BoxList stencil_bl(ixtype);
+    Vector<int> stencil_pmap;
+    Vector<int> plane_begin(nplanes+1, 0);
+
+    for (int p = 0; p < nplanes; ++p)
+    {
+        const int dir = planes[p].dir;
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(dir >= 0 && dir < AMREX_SPACEDIM,
+            "ExtractSlices: invalid plane direction");
+
+        // Position of the plane in index space of the points of mf
+        const Real x = (planes[p].position - geom.ProbLo(dir)) / geom.CellSize(dir)
+                       + geom.Domain().smallEnd(dir)
+                       - (ixtype.cellCentered(dir) ? 0.5_rt : 0.0_rt);
+        int i0 = static_cast<int>(std::floor(x));
+        Real w = x - i0;
+        if (i0 < domain.smallEnd(dir)) {
+            i0 = domain.smallEnd(dir);
+            w = 0.0_rt;
+        } else if (i0 >= domain.bigEnd(dir)) {
+            i0 = domain.bigEnd(dir);
+            w = 0.0_rt;
+        }
+        layer[p] = i0;
+        weight[p] = w;
+
+        Box plane_box = domain;
+        plane_box.setSmall(dir, i0);
+        plane_box.setBig(dir, i0);
+
+        plane_begin[p] = stencil_pmap.size();
+        for (const auto& isect : ba.intersections(plane_box))
+        {
+            Box b = isect.second;
+            if (w > 0.0_rt) b.growHi(dir, 1);
+            stencil_bl.push_back(b);
+            stencil_pmap.push_back(dm[isect.first]);
+        }
+    }
+    plane_begin[nplanes] = stencil_pmap.size();
+
+    // Gather the data around all the planes at once. The pieces are owned by the owners
+    // of the boxes of mf, so this is a local copy unless a piece spans two boxes of mf.
+    const BoxArray stencil_ba(std::move(stencil_bl));
+    const DistributionMapping stencil_dm(std::move(stencil_pmap));
+    MultiFab stencil(stencil_ba, stencil_dm, ncomp, 0);
+    stencil.ParallelCopy(mf, scomp, 0, ncomp);
+
+    Vector<std::unique_ptr<MultiFab>> slices;
+    for (int p = 0; p < nplanes; ++p)
+    {
+        const int dir = planes[p].dir;
+        const int i0 = layer[p];
+        const Real w = weight[p];
+
+        BoxList bl(ixtype);
+        Vector<int> pmap;
+        for (int ib = plane_begin[p]; ib < plane_begin[p+1]; ++ib) {
+            Box b = stencil_ba[ib];
+            b.setBig(dir, i0);
+            bl.push_back(b);
+            pmap.push_back(stencil_dm[ib]);
+        }
+        auto slice = std::make_unique<MultiFab>(BoxArray(std::move(bl)),
+                                                DistributionMapping(std::move(pmap)), ncomp, 0);
+
+        const int sx = (dir == 0);
+        const int sy = (dir == 1);
+        const int sz = (dir == 2);
+        for (MFIter mfi(*slice); mfi.isValid(); ++mfi)
+        {
+            Array4<Real const> const& src = stencil.const_array(plane_begin[p] + mfi.index());
+            Array4<Real> const& dst = slice->array(mfi);
+            amrex::ParallelFor(mfi.validbox(), ncomp,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+                {
+                    Real v = src(i,j,k,n);
+                    if (w > 0.0_rt) {
+                        v = (1.0_rt - w)*v + w*src(i+sx,j+sy,k+sz,n);
+                    }
+                    dst(i,j,k,n) = v;
+                });
+        }
+        slices.push_back(std::move(slice));
+    }
+    return slices;
+}
@@ -9,6 +9,7 @@
  */
 #include "BoundaryConditions/PML.H"
 #include "FieldIO.H"
+#include "IncrementalCheckpoint.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Utils/CoarsenIO.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -200,52 +201,52 @@ WarpX::InitFromCheckpoint ()
             }
         }
 
-        VisMF::Read(*Efield_fp[lev][0],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_fp"));
-        VisMF::Read(*Efield_fp[lev][1],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_fp"));
-        VisMF::Read(*Efield_fp[lev][2],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_fp"));
+        IncrementalCheckpoint::Read(*Efield_fp[lev][0],
+                                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_fp"));
+        IncrementalCheckpoint::Read(*Efield_fp[lev][1],
+                                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_fp"));
+        IncrementalCheckpoint::Read(*Efield_fp[lev][2],
+                                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_fp"));
 
-        VisMF::Read(*Bfield_fp[lev][0],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_fp"));
-        VisMF::Read(*Bfield_fp[lev][1],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_fp"));
-        VisMF::Read(*Bfield_fp[lev][2],
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_fp"));
+        IncrementalCheckpoint::Read(*Bfield_fp[lev][0],
+                                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_fp"));
+        IncrementalCheckpoint::Read(*Bfield_fp[lev][1],
+                                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_fp"));
+        IncrementalCheckpoint::Read(*Bfield_fp[lev][2],
+                                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_fp"));
 
         if (is_synchronized) {
-            VisMF::Read(*current_fp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_fp"));
-            VisMF::Read(*current_fp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_fp"));
-            VisMF::Read(*current_fp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_fp"));
+            IncrementalCheckpoint::Read(*current_fp[lev][0],
+                                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_fp"));
+            IncrementalCheckpoint::Read(*current_fp[lev][1],
+                                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_fp"));
+            IncrementalCheckpoint::Read(*current_fp[lev][2],
+                                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_fp"));
         }
 
         if (lev > 0)
         {
-            VisMF::Read(*Efield_cp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_cp"));
-            VisMF::Read(*Efield_cp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_cp"));
-            VisMF::Read(*Efield_cp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_cp"));
-
-            VisMF::Read(*Bfield_cp[lev][0],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_cp"));
-            VisMF::Read(*Bfield_cp[lev][1],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_cp"));
-            VisMF::Read(*Bfield_cp[lev][2],
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_cp"));
+            IncrementalCheckpoint::Read(*Efield_cp[lev][0],
+                                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_cp"));
+            IncrementalCheckpoint::Read(*Efield_cp[lev][1],
+                                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_cp"));
+            IncrementalCheckpoint::Read(*Efield_cp[lev][2],
+                                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_cp"));
+
+            IncrementalCheckpoint::Read(*Bfield_cp[lev][0],
+                                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_cp"));
+            IncrementalCheckpoint::Read(*Bfield_cp[lev][1],
+                                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_cp"));
+            IncrementalCheckpoint::Read(*Bfield_cp[lev][2],
+                                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_cp"));
 
             if (is_synchronized) {
-                VisMF::Read(*current_cp[lev][0],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_cp"));
-                VisMF::Read(*current_cp[lev][1],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_cp"));
-                VisMF::Read(*current_cp[lev][2],
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_cp"));
+                IncrementalCheckpoint::Read(*current_cp[lev][0],
+                                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_cp"));
+                IncrementalCheckpoint::Read(*current_cp[lev][1],
+                                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_cp"));
+                IncrementalCheckpoint::Read(*current_cp[lev][2],
+                                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_cp"));
             }
         }
     }
@@ -37,9 +37,12 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdint>
+#include <future>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <set>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -125,6 +128,35 @@ namespace detail
         return options;
     }
 
+    /** Create the option string of a dataset compressed by ZFP in fixed-accuracy mode
+     *
+     * @param tolerance absolute error bound of each value
+     * @return JSON option string for openPMD::Dataset
+     */
+    inline std::string
+    getDatasetCompressionOptions (amrex::Real tolerance)
+    {
+        std::ostringstream accuracy;
+        accuracy.precision(std::numeric_limits<amrex::Real>::max_digits10);
+        accuracy << tolerance;
+        return R"END(
+{
+  "adios2": {
+    "dataset": {
+      "operators": [
+        {
+          "type": "zfp",
+          "parameters": {
+            "accuracy": ")END" + accuracy.str() + R"END("
+          }
+        }
+      ]
+    }
+  }
+}
+)END";
+    }
+
     /** Unclutter a real_names to openPMD record
      *
      * @param fullName name as in real_names variable
@@ -297,11 +329,17 @@ WarpXOpenPMDPlot::WarpXOpenPMDPlot (
     std::string openPMDFileType,
     std::string operator_type,
     std::map< std::string, std::string > operator_parameters,
-    std::vector<bool> fieldPMLdirections)
+    amrex::Real compression_tolerance,
+    std::map< std::string, amrex::Real > compression_tolerances,
+    std::vector<bool> fieldPMLdirections,
+    bool async_flush)
   :m_Series(nullptr),
    m_Encoding(ie),
    m_OpenPMDFileType(std::move(openPMDFileType)),
-   m_fieldPMLdirections(std::move(fieldPMLdirections))
+   m_compression_tolerance(compression_tolerance),
+   m_compression_tolerances(std::move(compression_tolerances)),
+   m_fieldPMLdirections(std::move(fieldPMLdirections)),
+   m_async_flush(async_flush)
 {
   // pick first available backend if default is chosen
   if( m_OpenPMDFileType == "default" )
@@ -316,15 +354,71 @@ WarpXOpenPMDPlot::WarpXOpenPMDPlot (
 #endif
 
     m_OpenPMDoptions = detail::getSeriesOptions(operator_type, operator_parameters);
+
+    // the ZFP operator is only available with ADIOS2: check the backend that was
+    // actually selected, which may be HDF5 or ADIOS1 with the default one
+    if (m_compression_tolerance > 0. || !m_compression_tolerances.empty()) {
+#if openPMD_HAVE_ADIOS2==1
+        bool const can_compress = (m_OpenPMDFileType == "bp");
+#else
+        bool const can_compress = false;
+#endif
+        if (!can_compress) {
+            amrex::Warning("openPMD: compression_tolerance requires the ADIOS2 ('bp') backend, "
+                           "but the backend is '" + m_OpenPMDFileType + "': the data are "
+                           "written without compression");
+            m_compression_tolerance = 0.;
+            m_compression_tolerances.clear();
+        }
+    }
+
+#if defined(AMREX_USE_MPI)
+    if (m_async_flush && amrex::ParallelDescriptor::NProcs() > 1) {
+        // The background thread calls MPI while the main thread keeps on communicating
+        int thread_level = MPI_THREAD_SINGLE;
+        MPI_Query_thread(&thread_level);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(thread_level >= MPI_THREAD_MULTIPLE,
+            "openPMD: asynchronous flushes require MPI_THREAD_MULTIPLE "
+            "(configure WarpX with -DWarpX_MPI_THREAD_MULTIPLE=ON)");
+        MPI_Comm_dup(amrex::ParallelDescriptor::Communicator(), &m_async_comm);
+    }
+#endif
 }
 
 WarpXOpenPMDPlot::~WarpXOpenPMDPlot ()
 {
+  WaitForFlush();
   if( m_Series )
   {
     m_Series->flush();
     m_Series.reset( nullptr );
   }
+#if defined(AMREX_USE_MPI)
+  if (m_async_comm != MPI_COMM_NULL) MPI_Comm_free(&m_async_comm);
+#endif
+}
+
+void
+WarpXOpenPMDPlot::Flush ()
+{
+    if (!m_Series) return;
+    if (m_async_flush) {
+        WaitForFlush();
+        openPMD::Series* series = m_Series.get();
+        m_pending_flush = std::async(std::launch::async, [series] () { series->flush(); });
+    } else {
+        m_Series->flush();
+    }
+}
+
+void
+WarpXOpenPMDPlot::WaitForFlush ()
+{
+    if (m_pending_flush.valid()) {
+        WARPX_PROFILE("WarpXOpenPMDPlot::WaitForFlush()");
+        // get() also re-throws any exception raised by the background thread
+        m_pending_flush.get();
+    }
 }
 
 std::string
@@ -349,6 +443,9 @@ void WarpXOpenPMDPlot::SetStep (int ts, const std::string& dirPrefix, int file_m
 {
     AMREX_ALWAYS_ASSERT_WITH_MESSAGE(ts >= 0 , "openPMD iterations are unsigned");
 
+    // The previous flush must be complete before the Series is used again
+    WaitForFlush();
+
     m_dirPrefix = dirPrefix;
     m_file_min_digits = file_min_digits;
 
@@ -375,7 +472,8 @@ void WarpXOpenPMDPlot::CloseStep (bool isBTD, bool isLastBTDFlush)
     if (isBTD and !isLastBTDFlush) callClose = false;
     if (callClose) {
         if (m_Series) {
-            GetIteration(m_CurrentStep, isBTD).close();
+            // with asynchronous flushes, the iteration is actually closed in Flush() below
+            GetIteration(m_CurrentStep, isBTD).close(!m_async_flush);
         }
 
         // create a little helper file for ParaView 5.9+
@@ -390,6 +488,9 @@ void WarpXOpenPMDPlot::CloseStep (bool isBTD, bool isLastBTDFlush)
             pv_helper_file.close();
         }
     }
+
+    // with asynchronous flushes, this is the only flush of the step
+    if (m_async_flush) Flush();
 }
 
 void
@@ -414,7 +515,7 @@ WarpXOpenPMDPlot::Init (openPMD::Access access, bool isBTD)
 #if defined(AMREX_USE_MPI)
         m_Series = std::make_unique<openPMD::Series>(
                 filepath, access,
-                amrex::ParallelDescriptor::Communicator(),
+                m_async_flush ? m_async_comm : amrex::ParallelDescriptor::Communicator(),
                 m_OpenPMDoptions
         );
         m_MPISize = amrex::ParallelDescriptor::NProcs();
@@ -597,7 +698,8 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
   SetupRealProperties(currSpecies, write_real_comp, real_comp_names, write_int_comp, int_comp_names, counter.GetTotalNumParticles());
 
   // open files from all processors, in case some will not contribute below
-  m_Series->flush();
+  // (with asynchronous flushes, all processors take part in the flush of the step)
+  if (!m_async_flush) m_Series->flush();
 
   for (auto currentLevel = 0; currentLevel <= pc->finestLevel(); currentLevel++)
     {
@@ -684,7 +786,7 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
          offset += numParticleOnTile64;
       }
     }
-    m_Series->flush();
+    if (!m_async_flush) m_Series->flush();
 }
 
 void
@@ -711,9 +813,11 @@ WarpXOpenPMDPlot::SetupRealProperties (openPMD::ParticleSpecies& currSpecies,
     auto const real_counter = std::min(write_real_comp.size(), real_comp_names.size());
     for (int i = 0; i < real_counter; ++i) {
       if (write_real_comp[i]) {
-          getComponentRecord(real_comp_names[i]).resetDataset(dtype_real);
+          getComponentRecord(real_comp_names[i]).resetDataset(
+              CompressedDataset(dtype_real, real_comp_names[i]));
       }
     }
+    // integer attributes are never compressed, since ZFP is lossy
     auto const int_counter = std::min(write_int_comp.size(), int_comp_names.size());
     for (int i = 0; i < int_counter; ++i) {
         if (write_int_comp[i]) {
@@ -828,7 +932,8 @@ WarpXOpenPMDPlot::SaveRealProperty (ParticleIter& pti,
     for (auto idx=0; idx<real_counter; idx++) {
       auto ii = m_NumAoSRealAttributes + idx;
       if (write_real_comp[ii]) {
-        getComponentRecord(real_comp_names[ii]).storeChunk(openPMD::shareRaw(soa.GetRealData(idx)),
+        getComponentRecord(real_comp_names[ii]).storeChunk(
+          StageData(soa.GetRealData(idx).dataPtr(), numParticleOnTile),
           {offset}, {numParticleOnTile64});
       }
     }
@@ -839,7 +944,8 @@ WarpXOpenPMDPlot::SaveRealProperty (ParticleIter& pti,
     for (auto idx=0; idx<int_counter; idx++) {
       auto ii = m_NumAoSIntAttributes + idx; // jump over AoS names
       if (write_int_comp[ii]) {
-        getComponentRecord(int_comp_names[ii]).storeChunk(openPMD::shareRaw(soa.GetIntData(idx)),
+        getComponentRecord(int_comp_names[ii]).storeChunk(
+          StageData(soa.GetIntData(idx).dataPtr(), numParticleOnTile),
           {offset}, {numParticleOnTile64});
       }
     }
@@ -861,9 +967,10 @@ WarpXOpenPMDPlot::SetupPos (
   for( auto const& comp : positionComponents ) {
       currSpecies["positionOffset"][comp].resetDataset( realType );
       currSpecies["positionOffset"][comp].makeConstant( 0. );
-      currSpecies["position"][comp].resetDataset( realType );
+      currSpecies["position"][comp].resetDataset( CompressedDataset(realType, comp) );
   }
 
+  // the ids are never compressed, since ZFP is lossy
   auto const scalar = openPMD::RecordComponent::SCALAR;
   currSpecies["id"][scalar].resetDataset( idType );
   currSpecies["charge"][scalar].resetDataset( realType );
@@ -973,7 +1080,8 @@ WarpXOpenPMDPlot::SetupFields ( openPMD::Container< openPMD::Mesh >& meshes,
 void
 WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
                                  amrex::Geometry& full_geom,
-                                 openPMD::MeshRecordComponent& mesh_comp) const
+                                 openPMD::MeshRecordComponent& mesh_comp,
+                                 std::string const& varname) const
 {
        amrex::Box const & global_box = full_geom.Domain();
        auto const global_size = getReversedVec(global_box.size());
@@ -993,8 +1101,18 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
        mesh.setGridSpacing(grid_spacing);
        mesh.setGridGlobalOffset(global_offset);
        mesh.setAttribute("fieldSmoothing", "none");
-       mesh_comp.resetDataset(dataset);
+       mesh_comp.resetDataset(CompressedDataset(dataset, varname));
+
+}
 
+openPMD::Dataset
+WarpXOpenPMDPlot::CompressedDataset (openPMD::Dataset dataset, std::string const& name) const
+{
+    amrex::Real tolerance = m_compression_tolerance;
+    auto const it = m_compression_tolerances.find(name);
+    if (it != m_compression_tolerances.end()) tolerance = it->second;
+    if (tolerance > 0.) dataset.options = detail::getDatasetCompressionOptions(tolerance);
+    return dataset;
 }
 
 /*
@@ -1096,7 +1214,7 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
           auto mesh_comp = mesh[comp_name];
           if ( first_write_to_iteration )
           {
-             SetupMeshComp( mesh, full_geom, mesh_comp );
+             SetupMeshComp( mesh, full_geom, mesh_comp, varname );
              detail::setOpenPMDUnit( mesh, field_name );
 
              auto relative_cell_pos = utils::getRelativeCellPosition(mf[i]);     // AMReX Fortran index order
@@ -1117,12 +1235,13 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                 auto const chunk_size = getReversedVec( local_box.size() );
 
                 amrex::Real const * local_data = fab.dataPtr( icomp );
-                mesh_comp.storeChunk( openPMD::shareRaw(local_data),
+                mesh_comp.storeChunk( StageData(local_data, local_box.numPts()),
                                       chunk_offset, chunk_size );
             }
     } // icomp loop
     // Flush data to disk after looping over all components
-    m_Series->flush();
+    // (with asynchronous flushes, the data is flushed at the end of the step)
+    if (!m_async_flush) m_Series->flush();
   } // levels loop (i)
 }
 #endif // WARPX_USE_OPENPMD
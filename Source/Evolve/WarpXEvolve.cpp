@@ -26,6 +26,7 @@
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "Python/WarpX_py.H"
 #include "Utils/IntervalsParser.H"
+#include "Utils/StepTimers.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -70,6 +71,8 @@ WarpX::Evolve (int numsteps)
 
     static Real evolve_time = 0;
 
+    StepTimers::Start();
+
     for (int step = istep[0]; step < numsteps_max && cur_time < stop_time; ++step)
     {
         Real evolve_time_beg_step = amrex::second();
@@ -108,6 +111,9 @@ WarpX::Evolve (int numsteps)
             }
         }
 
+        // Time candidate grid and tile sizes during the first steps
+        if (do_autotune) Autotune();
+
         // At the beginning, we have B^{n} and E^{n}.
         // Particles have p^{n} and x^{n}.
         // is_synchronized is true.
@@ -239,11 +245,14 @@ WarpX::Evolve (int numsteps)
         ShiftGalileanBoundary();
 
         if (do_back_transformed_diagnostics) {
+            StepTimers::Scope step_timer(StepTimers::Diagnostics);
+            if (do_autotune) AutotuneStopTimer();
             std::unique_ptr<MultiFab> cell_centered_data = nullptr;
             if (WarpX::do_back_transformed_fields) {
                 cell_centered_data = GetCellCenteredData();
             }
             myBFD->writeLabFrameData(cell_centered_data.get(), *mypc, geom[0], cur_time, dt[0]);
+            if (do_autotune) AutotuneStartTimer();
         }
 
         bool move_j = is_synchronized;
@@ -316,6 +325,7 @@ WarpX::Evolve (int numsteps)
         if (warpx_py_afterstep) warpx_py_afterstep();
 
         Real evolve_time_end_step = amrex::second();
+        if (do_autotune) AutotuneStopTimer();
         evolve_time += evolve_time_end_step - evolve_time_beg_step;
 
         if (verbose) {
@@ -326,13 +336,17 @@ WarpX::Evolve (int numsteps)
                       << " s; Avg. per step = " << evolve_time/(step+1) << " s\n";
         }
 
-        /// reduced diags
-        if (reduced_diags->m_plot_rd != 0)
         {
-            reduced_diags->ComputeDiags(step);
-            reduced_diags->WriteToFile(step);
+            StepTimers::Scope step_timer(StepTimers::Diagnostics);
+
+            /// reduced diags
+            if (reduced_diags->m_plot_rd != 0)
+            {
+                reduced_diags->ComputeDiags(step);
+                reduced_diags->WriteToFile(step);
+            }
+            multi_diags->FilterComputePackFlush( step );
         }
-        multi_diags->FilterComputePackFlush( step );
 
         // inputs: unused parameters (e.g. typos) check after step 1 has finished
         if (!early_params_checked) {
@@ -795,6 +809,8 @@ WarpX::PushParticlesandDepose (amrex::Real cur_time, bool skip_deposition)
 void
 WarpX::PushParticlesandDepose (int lev, amrex::Real cur_time, DtType a_dt_type, bool skip_deposition)
 {
+    StepTimers::Scope step_timer(StepTimers::PushDeposit);
+
     // If warpx.do_current_centering = 1, the current is deposited on the nodal MultiFab current_fp_nodal
     // and then centered onto the staggered MultiFab current_fp
     amrex::MultiFab* current_x = (WarpX::do_current_centering) ? current_fp_nodal[lev][0].get()
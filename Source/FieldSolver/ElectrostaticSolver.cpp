@@ -10,6 +10,7 @@
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Python/WarpX_py.H"
+#include "Utils/StepTimers.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXUtil.H"
@@ -58,6 +59,8 @@ void
 WarpX::ComputeSpaceChargeField (bool const reset_fields)
 {
     WARPX_PROFILE("WarpX::ComputeSpaceChargeField");
+    StepTimers::Scope step_timer(StepTimers::FieldSolve);
+
     if (reset_fields) {
         // Reset all E and B fields to 0, before calculating space-charge fields
         WARPX_PROFILE("WarpX::ComputeSpaceChargeField::reset_fields");
@@ -1,5 +1,6 @@
 #include "ComovingPsatdAlgorithm.H"
 
+#include "Utils/MemoryCounter.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpX_Complex.H"
 
@@ -523,4 +524,16 @@ ComovingPsatdAlgorithm::VayDeposition (const int /*lev*/,
     amrex::Abort("Vay deposition not implemented for comoving PSATD");
 }
 
+void
+ComovingPsatdAlgorithm::CountMemory (MemoryCounter& counter) const
+{
+    counter.add(C_coef);
+    counter.add(S_ck_coef);
+    counter.add(Theta2_coef);
+    counter.add(X1_coef);
+    counter.add(X2_coef);
+    counter.add(X3_coef);
+    counter.add(X4_coef);
+}
+
 #endif // WARPX_USE_PSATD
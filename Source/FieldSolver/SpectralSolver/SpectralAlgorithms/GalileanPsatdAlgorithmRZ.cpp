@@ -5,6 +5,7 @@
  * License: BSD-3-Clause-LBNL
  */
 #include "GalileanPsatdAlgorithmRZ.H"
+#include "Utils/MemoryCounter.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
@@ -383,3 +384,16 @@ GalileanPsatdAlgorithmRZ::VayDeposition (const int /*lev*/,
 {
     amrex::Abort("Vay deposition not implemented in RZ geometry");
 }
+
+void
+GalileanPsatdAlgorithmRZ::CountMemory (MemoryCounter& counter) const
+{
+    counter.add(C_coef);
+    counter.add(S_ck_coef);
+    counter.add(Theta2_coef);
+    counter.add(T_rho_coef);
+    counter.add(X1_coef);
+    counter.add(X2_coef);
+    counter.add(X3_coef);
+    counter.add(X4_coef);
+}
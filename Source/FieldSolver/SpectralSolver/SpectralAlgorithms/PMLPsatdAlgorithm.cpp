@@ -8,6 +8,7 @@
 
 #include "FieldSolver/SpectralSolver/SpectralFieldData.H"
 #include "FieldSolver/SpectralSolver/SpectralKSpace.H"
+#include "Utils/MemoryCounter.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpX_Complex.H"
 
@@ -418,4 +419,12 @@ PMLPsatdAlgorithm::VayDeposition (const int /*lev*/,
     amrex::Abort("Vay deposition not implemented for PML PSATD");
 }
 
+void
+PMLPsatdAlgorithm::CountMemory (MemoryCounter& counter) const
+{
+    counter.add(C_coef);
+    counter.add(S_ck_coef);
+    counter.add(inv_k2_coef);
+}
+
 #endif // WARPX_USE_PSATD
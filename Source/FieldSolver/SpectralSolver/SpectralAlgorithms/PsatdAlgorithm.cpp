@@ -6,6 +6,7 @@
  */
 #include "PsatdAlgorithm.H"
 
+#include "Utils/MemoryCounter.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpX_Complex.H"
 
@@ -1079,4 +1080,24 @@ PsatdAlgorithm::VayDeposition (
     field_data.BackwardTransform(lev, *current[2], Idx.Jz, 0, fill_guards);
 }
 
+void
+PsatdAlgorithm::CountMemory (MemoryCounter& counter) const
+{
+    counter.add(C_coef);
+    counter.add(S_ck_coef);
+    counter.add(T2_coef);
+    counter.add(X1_coef);
+    counter.add(X2_coef);
+    counter.add(X3_coef);
+    counter.add(X4_coef);
+    counter.add(X5_coef);
+    counter.add(X6_coef);
+    counter.add(Psi1_coef);
+    counter.add(Psi2_coef);
+    counter.add(Y1_coef);
+    counter.add(Y2_coef);
+    counter.add(Y3_coef);
+    counter.add(Y4_coef);
+}
+
 #endif // WARPX_USE_PSATD
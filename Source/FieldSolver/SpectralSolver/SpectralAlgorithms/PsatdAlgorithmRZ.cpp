@@ -5,6 +5,7 @@
  * License: BSD-3-Clause-LBNL
  */
 #include "PsatdAlgorithmRZ.H"
+#include "Utils/MemoryCounter.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
@@ -503,3 +504,15 @@ PsatdAlgorithmRZ::VayDeposition (const int /* lev */,
 {
     amrex::Abort("Vay deposition not implemented in RZ geometry");
 }
+
+void
+PsatdAlgorithmRZ::CountMemory (MemoryCounter& counter) const
+{
+    counter.add(C_coef);
+    counter.add(S_ck_coef);
+    counter.add(X1_coef);
+    counter.add(X2_coef);
+    counter.add(X3_coef);
+    counter.add(X5_coef);
+    counter.add(X6_coef);
+}
@@ -7,6 +7,7 @@
  */
 #include "SpectralFieldData.H"
 
+#include "Utils/MemoryCounter.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "WarpX.H"
 
@@ -422,4 +423,12 @@ SpectralFieldData::BackwardTransform (const int lev,
     }
 }
 
+void
+SpectralFieldData::CountMemory (MemoryCounter& counter) const
+{
+    counter.add(fields);
+    counter.add(tmpSpectralField);
+    counter.add(tmpRealField);
+}
+
 #endif // WARPX_USE_PSATD
@@ -6,6 +6,7 @@
  */
 #include "SpectralFieldDataRZ.H"
 
+#include "Utils/MemoryCounter.H"
 #include "WarpX.H"
 
 using amrex::operator""_rt;
@@ -804,3 +805,11 @@ SpectralFieldDataRZ::ApplyFilter (const int lev, int const field_index1,
         }
     }
 }
+
+void
+SpectralFieldDataRZ::CountMemory (MemoryCounter& counter) const
+{
+    counter.add(fields);
+    counter.add(tempHTransformed);
+    counter.add(tmpSpectralField);
+}
@@ -19,6 +19,7 @@
 #       include "FieldSolver/SpectralSolver/SpectralSolver.H"
 #   endif
 #endif
+#include "Utils/StepTimers.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -404,6 +405,8 @@ WarpX::PSATDScaleAverageFields (const amrex::Real scale_factor)
 void
 WarpX::PushPSATD ()
 {
+    StepTimers::Scope step_timer(StepTimers::FieldSolve);
+
 #ifndef WARPX_USE_PSATD
     amrex::Abort("PushFieldsEM: PSATD solver selected but not built");
 #else
@@ -457,6 +460,7 @@ WarpX::EvolveB (int lev, amrex::Real a_dt, DtType a_dt_type)
 void
 WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_type)
 {
+    StepTimers::Scope step_timer(StepTimers::FieldSolve);
 
     // Evolve B field in regular cells
     if (patch_type == PatchType::fine) {
@@ -507,6 +511,8 @@ WarpX::EvolveE (int lev, amrex::Real a_dt)
 void
 WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
 {
+    StepTimers::Scope step_timer(StepTimers::FieldSolve);
+
     // Evolve E field in regular cells
     if (patch_type == PatchType::fine) {
         m_fdtd_solver_fp[lev]->EvolveE(Efield_fp[lev], Bfield_fp[lev],
@@ -568,6 +574,7 @@ WarpX::EvolveF (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_typ
     if (!do_dive_cleaning) return;
 
     WARPX_PROFILE("WarpX::EvolveF()");
+    StepTimers::Scope step_timer(StepTimers::FieldSolve);
 
     const int rhocomp = (a_dt_type == DtType::FirstHalf) ? 0 : 1;
 
@@ -622,6 +629,7 @@ WarpX::EvolveG (int lev, PatchType patch_type, amrex::Real a_dt, DtType /*a_dt_t
     if (!do_divb_cleaning) return;
 
     WARPX_PROFILE("WarpX::EvolveG()");
+    StepTimers::Scope step_timer(StepTimers::FieldSolve);
 
     // Evolve G field in regular cells
     if (patch_type == PatchType::fine)
@@ -656,6 +664,8 @@ WarpX::MacroscopicEvolveE (int lev, amrex::Real a_dt) {
 
 void
 WarpX::MacroscopicEvolveE (int lev, PatchType patch_type, amrex::Real a_dt) {
+    StepTimers::Scope step_timer(StepTimers::FieldSolve);
+
     if (patch_type == PatchType::fine) {
         m_fdtd_solver_fp[lev]->MacroscopicEvolveE( Efield_fp[lev], Bfield_fp[lev],
                                              current_fp[lev], a_dt,
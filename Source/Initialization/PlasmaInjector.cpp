@@ -27,6 +27,7 @@
 #include <AMReX_Parser.H>
 #include <AMReX_Print.H>
 #include <AMReX_RandomEngine.H>
+#include <AMReX_RealBox.H>
 
 #include <algorithm>
 #include <cctype>
@@ -311,74 +312,80 @@ PlasmaInjector::PlasmaInjector (int ispecies, const std::string& name)
         queryWithParser(pp_species_name, "z_shift",z_shift);
 
 #ifdef WARPX_USE_OPENPMD
-        if (ParallelDescriptor::IOProcessor()) {
+        // The file is opened on all ranks, which then each read a chunk of the particles
+        if (ParallelDescriptor::NProcs() > 1) {
+#if defined(AMREX_USE_MPI)
+            m_openpmd_input_series = std::make_unique<openPMD::Series>(
+                str_injection_file, openPMD::Access::READ_ONLY,
+                ParallelDescriptor::Communicator());
+#else
+            amrex::Abort("openPMD-api not built with MPI support!");
+#endif
+        } else {
             m_openpmd_input_series = std::make_unique<openPMD::Series>(
                 str_injection_file, openPMD::Access::READ_ONLY);
+        }
+
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            m_openpmd_input_series->iterations.size() == 1u,
+            "External file should contain only 1 iteration\n");
+        openPMD::Iteration it = m_openpmd_input_series->iterations.begin()->second;
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            it.particles.size() == 1u,
+            "External file should contain only 1 species\n");
+        std::string const ps_name = it.particles.begin()->first;
+        openPMD::ParticleSpecies ps = it.particles.begin()->second;
 
-            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
-                m_openpmd_input_series->iterations.size() == 1u,
-                "External file should contain only 1 iteration\n");
-            openPMD::Iteration it = m_openpmd_input_series->iterations.begin()->second;
-            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
-                it.particles.size() == 1u,
-                "External file should contain only 1 species\n");
-            std::string const ps_name = it.particles.begin()->first;
-            openPMD::ParticleSpecies ps = it.particles.begin()->second;
-
-            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
-                ps.contains("charge") || charge_is_specified || species_is_specified,
-                std::string("'") + ps_name +
-                ".injection_file' does not contain a 'charge' species record. "
-                "Please specify '" + ps_name + ".charge' or "
-                "'" + ps_name + ".species_type' in your input file!\n");
-            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
-                ps.contains("mass") || mass_is_specified || species_is_specified,
-                std::string("'") + ps_name +
-                ".injection_file' does not contain a 'mass' species record. "
-                "Please specify '" + ps_name + ".mass' or "
-                "'" + ps_name + ".species_type' in your input file!\n");
-
-            if (charge_is_specified) {
-                Print() << "WARNING: Both '" << ps_name << ".charge' and '"
-                        << ps_name << ".injection_file' specify a charge.\n'"
-                        << ps_name << ".charge' will take precedence.\n";
-            }
-            else if (species_is_specified) {
-                Print() << "WARNING: Both '" << ps_name << ".species_type' and '"
-                        << ps_name << ".injection_file' specify a charge.\n'"
-                        << ps_name << ".species_type' will take precedence.\n";
-            }
-            else {
-                // TODO: Add ASSERT_WITH_MESSAGE to test if charge is a constant record
-                ParticleReal const p_q = ps["charge"][openPMD::RecordComponent::SCALAR].loadChunk<ParticleReal>().get()[0];
-                double const charge_unit = ps["charge"][openPMD::RecordComponent::SCALAR].unitSI();
-                charge = p_q * charge_unit;
-            }
-            if (mass_is_specified) {
-                Print() << "WARNING: Both '" << ps_name << ".mass' and '"
-                        << ps_name << ".injection_file' specify a mass.\n'"
-                        << ps_name << ".mass' will take precedence.\n";
-            }
-            else if (species_is_specified) {
-                Print() << "WARNING: Both '" << ps_name << ".species_type' and '"
-                        << ps_name << ".injection_file' specify a mass.\n'"
-                        << ps_name << ".species_type' will take precedence.\n";
-            }
-            else {
-                // TODO: Add ASSERT_WITH_MESSAGE to test if mass is a constant record
-                ParticleReal const p_m = ps["mass"][openPMD::RecordComponent::SCALAR].loadChunk<ParticleReal>().get()[0];
-                double const mass_unit = ps["mass"][openPMD::RecordComponent::SCALAR].unitSI();
-                mass = p_m * mass_unit;
-            }
-        } // IOProcessor
-
-        // Broadcast charge and mass to non-IO processors
-        if (!charge_is_specified && !species_is_specified)
-            ParallelDescriptor::Bcast(&charge, 1,
-                ParallelDescriptor::IOProcessorNumber());
-        if (!mass_is_specified && !species_is_specified)
-            ParallelDescriptor::Bcast(&mass, 1,
-                ParallelDescriptor::IOProcessorNumber());
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            ps.contains("charge") || charge_is_specified || species_is_specified,
+            std::string("'") + ps_name +
+            ".injection_file' does not contain a 'charge' species record. "
+            "Please specify '" + ps_name + ".charge' or "
+            "'" + ps_name + ".species_type' in your input file!\n");
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+            ps.contains("mass") || mass_is_specified || species_is_specified,
+            std::string("'") + ps_name +
+            ".injection_file' does not contain a 'mass' species record. "
+            "Please specify '" + ps_name + ".mass' or "
+            "'" + ps_name + ".species_type' in your input file!\n");
+
+        if (charge_is_specified) {
+            Print() << "WARNING: Both '" << ps_name << ".charge' and '"
+                    << ps_name << ".injection_file' specify a charge.\n'"
+                    << ps_name << ".charge' will take precedence.\n";
+        }
+        else if (species_is_specified) {
+            Print() << "WARNING: Both '" << ps_name << ".species_type' and '"
+                    << ps_name << ".injection_file' specify a charge.\n'"
+                    << ps_name << ".species_type' will take precedence.\n";
+        }
+        else {
+            // TODO: Add ASSERT_WITH_MESSAGE to test if charge is a constant record
+            // only read the first element: the record is read on all ranks
+            std::shared_ptr<ParticleReal> p_q =
+                ps["charge"][openPMD::RecordComponent::SCALAR].loadChunk<ParticleReal>({0u}, {1u});
+            m_openpmd_input_series->flush();
+            double const charge_unit = ps["charge"][openPMD::RecordComponent::SCALAR].unitSI();
+            charge = p_q.get()[0] * charge_unit;
+        }
+        if (mass_is_specified) {
+            Print() << "WARNING: Both '" << ps_name << ".mass' and '"
+                    << ps_name << ".injection_file' specify a mass.\n'"
+                    << ps_name << ".mass' will take precedence.\n";
+        }
+        else if (species_is_specified) {
+            Print() << "WARNING: Both '" << ps_name << ".species_type' and '"
+                    << ps_name << ".injection_file' specify a mass.\n'"
+                    << ps_name << ".species_type' will take precedence.\n";
+        }
+        else {
+            // TODO: Add ASSERT_WITH_MESSAGE to test if mass is a constant record
+            std::shared_ptr<ParticleReal> p_m =
+                ps["mass"][openPMD::RecordComponent::SCALAR].loadChunk<ParticleReal>({0u}, {1u});
+            m_openpmd_input_series->flush();
+            double const mass_unit = ps["mass"][openPMD::RecordComponent::SCALAR].unitSI();
+            mass = p_m.get()[0] * mass_unit;
+        }
 #else
         Abort("Plasma injection via external_file requires openPMD support: "
                      "Add USE_OPENPMD=TRUE when compiling WarpX.\n");
@@ -388,6 +395,37 @@ PlasmaInjector::PlasmaInjector (int ispecies, const std::string& name)
         StringParseAbortMessage("Injection style", injection_style);
     }
 
+    // Optionally, the parser profiles are tabulated on a grid coarser than
+    // the level 0 grid, and interpolated when particles are injected.
+    pp_species_name.query("do_profile_table", do_profile_table);
+    if (do_profile_table) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(WarpX::gamma_boost == 1._rt,
+            (species_name + ".do_profile_table is not supported in a boosted frame").c_str());
+        int coarsening = 4;
+        queryWithParser(pp_species_name, "profile_table_coarsening", coarsening);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(coarsening >= 1,
+            (species_name + ".profile_table_coarsening must be at least 1").c_str());
+        queryWithParser(pp_species_name, "profile_table_tolerance", profile_table_tolerance);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(profile_table_tolerance >= 0._rt,
+            (species_name + ".profile_table_tolerance must not be negative").c_str());
+        queryWithParser(pp_species_name, "profile_table_max_nodes", profile_table_max_nodes);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(profile_table_max_nodes > 0,
+            (species_name + ".profile_table_max_nodes must be positive").c_str());
+        const auto dx = geom.CellSizeArray();
+#if defined(WARPX_DIM_3D)
+        profile_table_dx[0] = coarsening*dx[0];
+        profile_table_dx[1] = coarsening*dx[1];
+        profile_table_dx[2] = coarsening*dx[2];
+#elif defined(WARPX_DIM_XZ)
+        profile_table_dx[0] = coarsening*dx[0];
+        profile_table_dx[2] = coarsening*dx[1];
+#elif defined(WARPX_DIM_RZ)
+        profile_table_dx[0] = coarsening*dx[0];
+        profile_table_dx[1] = coarsening*dx[0];
+        profile_table_dx[2] = coarsening*dx[1];
+#endif
+    }
+
     if (h_inj_pos) {
 #ifdef AMREX_USE_GPU
         d_inj_pos = static_cast<InjectorPosition*>
@@ -436,6 +474,105 @@ PlasmaInjector::~PlasmaInjector ()
 #endif
 }
 
+void PlasmaInjector::updateProfileTables (const amrex::RealBox& region)
+{
+    if (!do_profile_table) return;
+
+    // Extent of the region in (x,y,z), the coordinates of the profiles
+    Real lo[3], hi[3];
+#if defined(WARPX_DIM_3D)
+    for (int d = 0; d < 3; ++d) {
+        lo[d] = region.lo(d);
+        hi[d] = region.hi(d);
+    }
+#elif defined(WARPX_DIM_XZ)
+    lo[0] = region.lo(0);
+    hi[0] = region.hi(0);
+    lo[1] = hi[1] = 0._rt;
+    lo[2] = region.lo(1);
+    hi[2] = region.hi(1);
+#elif defined(WARPX_DIM_RZ)
+    lo[0] = lo[1] = -region.hi(0);
+    hi[0] = hi[1] = region.hi(0);
+    lo[2] = region.lo(1);
+    hi[2] = region.hi(1);
+#endif
+    // No particles are injected outside of the plasma bounds
+    const Real plasma_lo[3] = {xmin, ymin, zmin};
+    const Real plasma_hi[3] = {xmax, ymax, zmax};
+    for (int d = 0; d < 3; ++d) {
+        lo[d] = std::max(lo[d], plasma_lo[d]);
+        hi[d] = std::min(hi[d], plasma_hi[d]);
+        if (lo[d] > hi[d]) return;
+    }
+
+    const bool update_density = density_parser && !density_table.contains(lo, hi);
+    const bool update_momentum = ux_parser && !momentum_table.contains(lo, hi);
+    if (!update_density && !update_momentum) return;
+
+    // Tabulate ahead of the moving window, so that the table is
+    // not rebuilt every time that particles are injected
+    if (WarpX::do_moving_window) {
+#if defined(WARPX_DIM_3D)
+        const int dir = WarpX::moving_window_dir;
+#else
+        const int dir = (WarpX::moving_window_dir == 0) ? 0 : 2;
+#endif
+        const Real lookahead = profile_table_lookahead*profile_table_dx[dir];
+        if (WarpX::moving_window_v >= 0._rt) {
+            hi[dir] = std::min(hi[dir] + lookahead, plasma_hi[dir]);
+        } else {
+            lo[dir] = std::max(lo[dir] - lookahead, plasma_lo[dir]);
+        }
+    }
+
+    // The region of a rank can be much larger than its boxes (e.g. boxes spread
+    // over the domain), in which case the profiles are evaluated with the parser
+    if (InjectorProfileTable::numNodes(lo, hi, profile_table_dx) >
+        static_cast<double>(profile_table_max_nodes)) {
+        if (!profile_table_size_warned) {
+            amrex::AllPrint() << "WARNING: the injection region of species " << species_name
+                              << " on rank " << ParallelDescriptor::MyProc()
+                              << " needs a profile table larger than profile_table_max_nodes:"
+                              << " the parser is used instead\n";
+            profile_table_size_warned = true;
+        }
+        return;
+    }
+
+    if (update_density) {
+        const auto parser = density_parser->compile<3>();
+        density_table.build(lo, hi, profile_table_dx, 1, profile_table_tolerance,
+            [=] AMREX_GPU_DEVICE (Real x, Real y, Real z, Real* val) noexcept
+            {
+                val[0] = parser(x,y,z);
+            });
+        h_inj_rho->setTable(density_table.view());
+#ifdef AMREX_USE_GPU
+        amrex::Gpu::htod_memcpy_async(d_inj_rho, h_inj_rho.get(), sizeof(InjectorDensity));
+#endif
+    }
+
+    if (update_momentum) {
+        const auto ux = ux_parser->compile<3>();
+        const auto uy = uy_parser->compile<3>();
+        const auto uz = uz_parser->compile<3>();
+        momentum_table.build(lo, hi, profile_table_dx, 3, profile_table_tolerance,
+            [=] AMREX_GPU_DEVICE (Real x, Real y, Real z, Real* val) noexcept
+            {
+                val[0] = ux(x,y,z);
+                val[1] = uy(x,y,z);
+                val[2] = uz(x,y,z);
+            });
+        h_inj_mom->setTable(momentum_table.view());
+#ifdef AMREX_USE_GPU
+        amrex::Gpu::htod_memcpy_async(d_inj_mom, h_inj_mom.get(), sizeof(InjectorMomentum));
+#endif
+    }
+
+    amrex::Gpu::synchronize();
+}
+
 // Depending on injection type at runtime, initialize inj_rho
 // so that inj_rho->getDensity calls
 // InjectorPosition[Constant or Custom or etc.].getDensity.
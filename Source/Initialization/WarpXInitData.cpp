@@ -169,6 +169,8 @@ WarpX::InitData ()
     }
 
     PerformanceHints();
+
+    if (do_autotune) InitAutotune();
 }
 
 void
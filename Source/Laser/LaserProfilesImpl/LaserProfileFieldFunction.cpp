@@ -49,6 +49,7 @@ WarpXLaserProfiles::FieldFunctionLaserProfile::init (
     for (auto const& s : symbols) { // make sure there no unknown symbols
         amrex::Abort("Laser Profile: Unknown symbol "+s);
     }
+    m_parser_exe = m_parser.compile<3>();
 }
 
 void
@@ -56,7 +57,7 @@ WarpXLaserProfiles::FieldFunctionLaserProfile::fill_amplitude (
     const int np, Real const * AMREX_RESTRICT const Xp, Real const * AMREX_RESTRICT const Yp,
     Real t, Real * AMREX_RESTRICT const amplitude) const
 {
-    auto parser = m_parser.compile<3>();
+    auto const parser = m_parser_exe;
     amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
     {
         amplitude[i] = parser(Xp[i], Yp[i], t);
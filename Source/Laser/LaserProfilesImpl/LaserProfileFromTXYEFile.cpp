@@ -26,8 +26,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <limits>
 #include <string>
@@ -37,6 +39,39 @@
 
 using namespace amrex;
 
+namespace
+{
+    /** \brief Read the field data of timesteps [i_first, i_last] from a txye file
+    *
+    * This function only uses its arguments, so that it can run in a background thread.
+    *
+    * \param file_name: name of the txye file
+    * \param data_offset: position of the field data in the file (bytes)
+    * \param i_first: first timestep to read
+    * \param i_last: last timestep to read
+    * \param nxy: number of points of each timestep
+    * \param chunk_size: size of the returned vector (at least (i_last-i_first+1)*nxy)
+    * \return the field data, or an empty vector if the file could not be read
+    */
+    Vector<Real> read_txye_data (const std::string& file_name, std::size_t data_offset,
+                                 int i_first, int i_last, std::size_t nxy,
+                                 std::size_t chunk_size)
+    {
+        std::ifstream inp(file_name, std::ios::binary);
+        if(!inp) return Vector<Real>();
+        inp.seekg(data_offset + sizeof(double)*i_first*nxy);
+        if(!inp) return Vector<Real>();
+        const std::size_t read_size = (i_last - i_first + 1)*nxy;
+        Vector<double> buf_e(read_size);
+        inp.read(reinterpret_cast<char*>(buf_e.dataPtr()), read_size*sizeof(double));
+        if(!inp) return Vector<Real>();
+        Vector<Real> h_E_data(chunk_size);
+        std::transform(buf_e.begin(), buf_e.end(), h_E_data.begin(),
+            [](auto x) {return static_cast<amrex::Real>(x);} );
+        return h_E_data;
+    }
+}
+
 void
 WarpXLaserProfiles::FromTXYEFileLaserProfile::init (
     const amrex::ParmParse& ppl,
@@ -71,6 +106,9 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::init (
     //Reads the (optional) delay
     ppl.query("delay", m_params.t_delay);
 
+    //Whether the next time chunk is read in the background
+    ppl.query("txye_prefetch", m_params.prefetch);
+
     //Allocate memory for E_data Vector
     const int data_size = m_params.time_chunk_size*
             m_params.nx*m_params.ny;
@@ -282,27 +320,30 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::read_data_t_chuck(int t_begin, int
     if(i_last-i_first+1 > static_cast<int>(m_params.E_data.size()))
         Abort("Data chunk to read from file is too large");
 
-    Vector<Real> h_E_data(m_params.E_data.size());
+    const std::size_t nxy = static_cast<std::size_t>(m_params.nx)*m_params.ny;
+    const std::size_t data_offset = 1 +
+        3*sizeof(uint32_t) +
+        m_params.t_coords.size()*sizeof(double) +
+        m_params.h_x_coords.size()*sizeof(double) +
+        m_params.h_y_coords.size()*sizeof(double);
+    const std::size_t chunk_size = m_params.E_data.size();
+
+    Vector<Real> h_E_data;
 
     if(ParallelDescriptor::IOProcessor()){
-        //Read data chunk
-        std::ifstream inp(m_params.txye_file_name, std::ios::binary);
-        if(!inp) Abort("Failed to open txye file");
-        auto skip_amount = 1 +
-            3*sizeof(uint32_t) +
-            m_params.t_coords.size()*sizeof(double) +
-            m_params.h_x_coords.size()*sizeof(double) +
-            m_params.h_y_coords.size()*sizeof(double) +
-            sizeof(double)*t_begin*m_params.nx*m_params.ny;
-        inp.seekg(skip_amount);
-        if(!inp) Abort("Failed to read field data from txye file");
-        const int read_size = (i_last - i_first + 1)*
-            m_params.nx*m_params.ny;
-        Vector<double> buf_e(read_size);
-        inp.read(reinterpret_cast<char*>(buf_e.dataPtr()), read_size*sizeof(double));
-        if(!inp) Abort("Failed to read field data from txye file");
-        std::transform(buf_e.begin(), buf_e.end(), h_E_data.begin(),
-            [](auto x) {return static_cast<amrex::Real>(x);} );
+        //Use the chunk read in the background if it is the one needed
+        if(m_prefetched_chunk.valid()){
+            auto prefetched = m_prefetched_chunk.get();
+            if(m_prefetched_t_begin == i_first) h_E_data = std::move(prefetched);
+        }
+        if(h_E_data.empty()){
+            h_E_data = read_txye_data(m_params.txye_file_name, data_offset,
+                                      i_first, i_last, nxy, chunk_size);
+        }
+        if(h_E_data.empty()) Abort("Failed to read field data from txye file");
+    }
+    else{
+        h_E_data.resize(chunk_size);
     }
 
     //Broadcast E_data
@@ -315,6 +356,18 @@ WarpXLaserProfiles::FromTXYEFileLaserProfile::read_data_t_chuck(int t_begin, int
     //Update first and last indices
     m_params.first_time_index = i_first;
     m_params.last_time_index = i_last;
+
+    //Start reading the next chunk, which begins with the last timestep of this one
+    //(see update), so that it is available when the laser reaches the end of this one
+    if(ParallelDescriptor::IOProcessor() && m_params.prefetch && i_last < m_params.nt-1){
+        const int next_first = i_last;
+        const int next_last = min(next_first + m_params.time_chunk_size - 1, m_params.nt-1);
+        m_prefetched_t_begin = next_first;
+        m_prefetched_chunk = std::async(std::launch::async,
+            [file_name = m_params.txye_file_name, data_offset, next_first, next_last, nxy, chunk_size] () {
+                return read_txye_data(file_name, data_offset, next_first, next_last, nxy, chunk_size);
+            });
+    }
 }
 
 void
@@ -132,16 +132,37 @@ WarpXLaserProfiles::GaussianLaserProfile::fill_amplitude (
     auto const tmp_profile_t_peak = m_params.t_peak;
     auto const tmp_beta = m_params.beta;
     auto const tmp_zeta = m_params.zeta;
-    auto const tmp_theta_stc = m_params.theta_stc;
     auto const tmp_profile_focal_distance = m_params.focal_distance;
+    auto const cos_theta_stc = std::cos(m_params.theta_stc);
+    auto const sin_theta_stc = std::sin(m_params.theta_stc);
+
+    // Without spatio-temporal couplings, the temporal envelope does not depend
+    // on the position: it is computed once, and the amplitude is separable
+    if (tmp_beta == 0._rt && tmp_zeta == 0._rt) {
+        const Complex stc_exponent = 1._rt / stretch_factor * inv_tau2 *
+            (t - tmp_profile_t_peak) * (t - tmp_profile_t_peak);
+        const Complex stcfactor = prefactor * amrex::exp( - stc_exponent );
+        amrex::ParallelFor(
+            np,
+            [=] AMREX_GPU_DEVICE (int i) {
+                // Exp argument for transverse envelope
+                const Complex exp_argument = - ( Xp[i]*Xp[i] + Yp[i]*Yp[i] ) * inv_complex_waist_2;
+                // stcfactor + transverse envelope
+                amplitude[i] = ( stcfactor * amrex::exp( exp_argument ) ).real();
+            }
+            );
+        return;
+    }
+
     // Loop through the macroparticle to calculate the proper amplitude
     amrex::ParallelFor(
         np,
         [=] AMREX_GPU_DEVICE (int i) {
+            const Real X_stc = Xp[i]*cos_theta_stc + Yp[i]*sin_theta_stc;
             const Complex stc_exponent = 1._rt / stretch_factor * inv_tau2 *
                 amrex::pow((t - tmp_profile_t_peak -
-                    tmp_beta*k0*(Xp[i]*std::cos(tmp_theta_stc) + Yp[i]*std::sin(tmp_theta_stc)) -
-                    2._rt *I*(Xp[i]*std::cos(tmp_theta_stc) + Yp[i]*std::sin(tmp_theta_stc))
+                    tmp_beta*k0*X_stc -
+                    2._rt *I*X_stc
                     *( tmp_zeta - tmp_beta*tmp_profile_focal_distance ) * inv_complex_waist_2),2);
             // stcfactor = everything but complex transverse envelope
             const Complex stcfactor = prefactor * amrex::exp( - stc_exponent );
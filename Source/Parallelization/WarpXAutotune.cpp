@@ -0,0 +1,211 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "WarpX.H"
+
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <AMReX.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <utility>
+
+using namespace amrex;
+
+void
+WarpX::InitAutotune ()
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(finest_level == 0,
+        "warpx.do_autotune is not supported with mesh refinement");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(autotune_trial_steps > 0,
+        "warpx.autotune_trial_steps must be positive");
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(numprocs == IntVect(0) || autotune_max_grid_size.empty(),
+        "warpx.autotune_max_grid_size cannot be used together with warpx.numprocs");
+
+    // Default to the values of the current run if no candidates are given. The
+    // max_grid_size of the current run is kept as is, as it may be anisotropic.
+    Vector<IntVect> max_grid_sizes;
+    for (int const mgs : autotune_max_grid_size) max_grid_sizes.push_back(IntVect(mgs));
+    if (max_grid_sizes.empty()) max_grid_sizes.push_back(maxGridSize(0));
+    Vector<int> tile_sizes = autotune_tile_size;
+    // Particle tiles are only used on CPU with tiling enabled
+    if (tile_sizes.empty() || !WarpXParticleContainer::do_tiling) {
+        tile_sizes.clear();
+        tile_sizes.push_back(-1);
+    }
+
+    m_autotune_candidates.clear();
+    for (IntVect const& mgs : max_grid_sizes) {
+        for (int const ts : tile_sizes) {
+            m_autotune_candidates.push_back({mgs, ts});
+        }
+    }
+    m_autotune_timings.assign(m_autotune_candidates.size(), std::numeric_limits<Real>::max());
+    m_autotune_step = 0;
+    m_autotune_timer_on = false;
+    m_autotune_elapsed = 0.;
+    m_autotune_done = false;
+
+    amrex::Print() << "Autotune: timing " << m_autotune_candidates.size()
+                   << " candidate configuration(s) over " << autotune_trial_steps
+                   << " step(s) each\n";
+}
+
+void
+WarpX::Autotune ()
+{
+    WARPX_PROFILE("WarpX::Autotune()");
+
+    if (m_autotune_done) return;
+
+    const int ncandidates = static_cast<int>(m_autotune_candidates.size());
+    const int icandidate = m_autotune_step / autotune_trial_steps;
+    const int istep_in_trial = m_autotune_step % autotune_trial_steps;
+    // The first step of each candidate includes transient costs (e.g., first-touch
+    // allocations after remaking the grids) and is not timed, unless it is the only one.
+    const int istep_timer_start = std::min(1, autotune_trial_steps-1);
+
+    if (istep_in_trial == 0) {
+        if (icandidate > 0) {
+            // Record the wall time of the previous candidate (slowest rank)
+            Real elapsed = m_autotune_elapsed;
+            ParallelDescriptor::ReduceRealMax(elapsed);
+            m_autotune_timings[icandidate-1] = elapsed;
+            m_autotune_elapsed = 0.;
+        }
+        if (icandidate < ncandidates) {
+            AutotuneApply(m_autotune_candidates[icandidate].first,
+                          m_autotune_candidates[icandidate].second);
+        } else {
+            // All candidates have been timed: select the fastest one
+            const auto ibest = static_cast<int>(std::distance(m_autotune_timings.begin(),
+                std::min_element(m_autotune_timings.begin(), m_autotune_timings.end())));
+            AutotuneApply(m_autotune_candidates[ibest].first, m_autotune_candidates[ibest].second);
+            AutotuneWriteResults(ibest);
+            m_autotune_timer_on = false;
+            m_autotune_done = true;
+            return;
+        }
+    }
+    // The timer is started here, after the grids have been remade, and stopped at
+    // the end of the PIC loop of this step (see WarpX::Evolve)
+    m_autotune_timer_on = (istep_in_trial >= istep_timer_start);
+    AutotuneStartTimer();
+    ++m_autotune_step;
+}
+
+void
+WarpX::AutotuneStartTimer ()
+{
+    if (m_autotune_timer_on) m_autotune_time_beg = amrex::second();
+}
+
+void
+WarpX::AutotuneStopTimer ()
+{
+    if (m_autotune_timer_on) m_autotune_elapsed += amrex::second() - m_autotune_time_beg;
+}
+
+namespace
+{
+    /** Write a max_grid_size with the syntax of the input file: amr.max_grid_size if
+     *  it is the same in all directions, amr.max_grid_size_x/y/z otherwise */
+    void
+    PrintMaxGridSize (std::ostream& os, const IntVect& max_grid_size)
+    {
+        if (max_grid_size == IntVect(max_grid_size[0])) {
+            os << "amr.max_grid_size = " << max_grid_size[0];
+        } else {
+            const char* suffix[3] = {"_x", "_y", "_z"};
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                if (idim > 0) os << "\n";
+                os << "amr.max_grid_size" << suffix[idim] << " = " << max_grid_size[idim];
+            }
+        }
+    }
+}
+
+void
+WarpX::AutotuneApply (const IntVect& max_grid_size, int tile_size)
+{
+    bool changed = false;
+    if (tile_size > 0) {
+        const IntVect new_tile_size(AMREX_D_DECL(tile_size, tile_size, tile_size));
+        changed = (new_tile_size != WarpXParticleContainer::tile_size);
+        WarpXParticleContainer::tile_size = new_tile_size;
+    }
+
+    const int lev = 0;
+    SetMaxGridSize(max_grid_size);
+    const BoxArray ba = MakeBaseGrids();
+    if (ba != boxArray(lev)) {
+        const DistributionMapping dm{ba};
+        RemakeLevel(lev, t_new[lev], ba, dm);
+        changed = true;
+    }
+
+    // Particles are sorted again in the new grids and tiles
+    if (changed) {
+        mypc->Redistribute();
+        mypc->defineAllParticleTiles();
+    }
+
+    if (verbose) {
+        amrex::Print() << "Autotune: trying amr.max_grid_size = " << max_grid_size;
+        if (tile_size > 0) amrex::Print() << ", particles.tile_size = " << tile_size;
+        amrex::Print() << " (" << boxArray(lev).size() << " boxes)\n";
+    }
+}
+
+void
+WarpX::AutotuneWriteResults (int ibest) const
+{
+    const IntVect max_grid_size = m_autotune_candidates[ibest].first;
+    const int tile_size = m_autotune_candidates[ibest].second;
+
+    amrex::Print() << "Autotune: selected amr.max_grid_size = " << max_grid_size;
+    if (tile_size > 0) amrex::Print() << ", particles.tile_size = " << tile_size;
+    amrex::Print() << " (" << m_autotune_timings[ibest] << " s)\n";
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        // The results are written with the syntax of the input file, so that they
+        // can be appended to the input file of later runs on the same machine
+        std::ofstream ofs{autotune_file, std::ofstream::out};
+        ofs << "# Written by the WarpX autotuner\n";
+        for (std::size_t i = 0; i < m_autotune_candidates.size(); ++i) {
+            ofs << "# amr.max_grid_size = " << m_autotune_candidates[i].first;
+            if (m_autotune_candidates[i].second > 0) {
+                ofs << ", particles.tile_size = " << m_autotune_candidates[i].second;
+            }
+            ofs << ": " << m_autotune_timings[i] << " s\n";
+        }
+        PrintMaxGridSize(ofs, max_grid_size);
+        ofs << "\n";
+        if (tile_size > 0) {
+            ofs << "particles.tile_size =";
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) ofs << " " << tile_size;
+            ofs << "\n";
+        }
+        ofs.close();
+    }
+}
@@ -12,6 +12,7 @@
 #include "Filter/BilinearFilter.H"
 #include "Utils/CoarsenMR.H"
 #include "Utils/IntervalsParser.H"
+#include "Utils/StepTimers.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpXComm_K.H"
@@ -48,6 +49,7 @@ void
 WarpX::UpdateAuxilaryData ()
 {
     WARPX_PROFILE("WarpX::UpdateAuxilaryData()");
+    StepTimers::Scope step_timer(StepTimers::Communication);
 
     if (Bfield_aux[0][0]->ixType() == Bfield_fp[0][0]->ixType()) {
         UpdateAuxilaryDataSameType();
@@ -290,28 +292,27 @@ WarpX::UpdateAuxilaryDataSameType ()
 
         // B field
         {
-            MultiFab dBx(Bfield_cp[lev][0]->boxArray(), dm, Bfield_cp[lev][0]->nComp(), ng);
-            MultiFab dBy(Bfield_cp[lev][1]->boxArray(), dm, Bfield_cp[lev][1]->nComp(), ng);
-            MultiFab dBz(Bfield_cp[lev][2]->boxArray(), dm, Bfield_cp[lev][2]->nComp(), ng);
-            dBx.setVal(0.0);
-            dBy.setVal(0.0);
-            dBz.setVal(0.0);
+            // The coarse aux data is copied directly into Bfield_cax when this MultiFab
+            // exists (i.e., with gather buffers), so that it does not need to be duplicated
+            // in a temporary MultiFab. The coarse patch data is subtracted on the fly below.
+            Array<std::unique_ptr<MultiFab>,3> Btmp;
+            for (int i = 0; i < 3; ++i) {
+                if (Bfield_cax[lev][i]) {
+                    Btmp[i] = std::make_unique<MultiFab>(
+                        *Bfield_cax[lev][i], amrex::make_alias, 0, Bfield_cax[lev][i]->nComp());
+                } else {
+                    Btmp[i] = std::make_unique<MultiFab>(
+                        Bfield_cp[lev][i]->boxArray(), dm, Bfield_cp[lev][i]->nComp(), ng);
+                }
+                Btmp[i]->setVal(0.0);
+            }
             // Guard cells may not be up to date beyond ng_FieldGather
             const amrex::IntVect& ng_src = guard_cells.ng_FieldGather;
-            // Copy Bfield_aux to the dB MultiFabs, using up to ng_src (=ng_FieldGather) guard
-            // cells from Bfield_aux and filling up to ng (=nGrow) guard cells in the dB MultiFabs
-            dBx.ParallelCopy(*Bfield_aux[lev-1][0], 0, 0, Bfield_aux[lev-1][0]->nComp(), ng_src, ng, crse_period);
-            dBy.ParallelCopy(*Bfield_aux[lev-1][1], 0, 0, Bfield_aux[lev-1][1]->nComp(), ng_src, ng, crse_period);
-            dBz.ParallelCopy(*Bfield_aux[lev-1][2], 0, 0, Bfield_aux[lev-1][2]->nComp(), ng_src, ng, crse_period);
-            if (Bfield_cax[lev][0])
-            {
-                MultiFab::Copy(*Bfield_cax[lev][0], dBx, 0, 0, Bfield_cax[lev][0]->nComp(), ng);
-                MultiFab::Copy(*Bfield_cax[lev][1], dBy, 0, 0, Bfield_cax[lev][1]->nComp(), ng);
-                MultiFab::Copy(*Bfield_cax[lev][2], dBz, 0, 0, Bfield_cax[lev][2]->nComp(), ng);
+            // Copy Bfield_aux to the Btmp MultiFabs, using up to ng_src (=ng_FieldGather) guard
+            // cells from Bfield_aux and filling up to ng (=nGrow) guard cells in the Btmp MultiFabs
+            for (int i = 0; i < 3; ++i) {
+                Btmp[i]->ParallelCopy(*Bfield_aux[lev-1][i], 0, 0, Bfield_aux[lev-1][i]->nComp(), ng_src, ng, crse_period);
             }
-            MultiFab::Subtract(dBx, *Bfield_cp[lev][0], 0, 0, Bfield_cp[lev][0]->nComp(), ng);
-            MultiFab::Subtract(dBy, *Bfield_cp[lev][1], 0, 0, Bfield_cp[lev][1]->nComp(), ng);
-            MultiFab::Subtract(dBz, *Bfield_cp[lev][2], 0, 0, Bfield_cp[lev][2]->nComp(), ng);
 
             const amrex::IntVect& refinement_ratio = refRatio(lev-1);
 
@@ -330,50 +331,52 @@ WarpX::UpdateAuxilaryDataSameType ()
                 Array4<Real const> const& bx_fp = Bfield_fp[lev][0]->const_array(mfi);
                 Array4<Real const> const& by_fp = Bfield_fp[lev][1]->const_array(mfi);
                 Array4<Real const> const& bz_fp = Bfield_fp[lev][2]->const_array(mfi);
-                Array4<Real const> const& bx_c = dBx.const_array(mfi);
-                Array4<Real const> const& by_c = dBy.const_array(mfi);
-                Array4<Real const> const& bz_c = dBz.const_array(mfi);
+                Array4<Real const> const& bx_cp = Bfield_cp[lev][0]->const_array(mfi);
+                Array4<Real const> const& by_cp = Bfield_cp[lev][1]->const_array(mfi);
+                Array4<Real const> const& bz_cp = Bfield_cp[lev][2]->const_array(mfi);
+                Array4<Real const> const& bx_c = Btmp[0]->const_array(mfi);
+                Array4<Real const> const& by_c = Btmp[1]->const_array(mfi);
+                Array4<Real const> const& bz_c = Btmp[2]->const_array(mfi);
 
                 amrex::ParallelFor(Box(bx_aux), Box(by_aux), Box(bz_aux),
                 [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
                 {
-                    warpx_interp(j, k, l, bx_aux, bx_fp, bx_c, Bx_stag, refinement_ratio);
+                    warpx_interp(j, k, l, bx_aux, bx_fp, bx_c, bx_cp, Bx_stag, refinement_ratio);
                 },
                 [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
                 {
-                    warpx_interp(j, k, l, by_aux, by_fp, by_c, By_stag, refinement_ratio);
+                    warpx_interp(j, k, l, by_aux, by_fp, by_c, by_cp, By_stag, refinement_ratio);
                 },
                 [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
                 {
-                    warpx_interp(j, k, l, bz_aux, bz_fp, bz_c, Bz_stag, refinement_ratio);
+                    warpx_interp(j, k, l, bz_aux, bz_fp, bz_c, bz_cp, Bz_stag, refinement_ratio);
                 });
             }
         }
 
         // E field
         {
-            MultiFab dEx(Efield_cp[lev][0]->boxArray(), dm, Efield_cp[lev][0]->nComp(), ng);
-            MultiFab dEy(Efield_cp[lev][1]->boxArray(), dm, Efield_cp[lev][1]->nComp(), ng);
-            MultiFab dEz(Efield_cp[lev][2]->boxArray(), dm, Efield_cp[lev][2]->nComp(), ng);
-            dEx.setVal(0.0);
-            dEy.setVal(0.0);
-            dEz.setVal(0.0);
+            // The coarse aux data is copied directly into Efield_cax when this MultiFab
+            // exists (i.e., with gather buffers), so that it does not need to be duplicated
+            // in a temporary MultiFab. The coarse patch data is subtracted on the fly below.
+            Array<std::unique_ptr<MultiFab>,3> Etmp;
+            for (int i = 0; i < 3; ++i) {
+                if (Efield_cax[lev][i]) {
+                    Etmp[i] = std::make_unique<MultiFab>(
+                        *Efield_cax[lev][i], amrex::make_alias, 0, Efield_cax[lev][i]->nComp());
+                } else {
+                    Etmp[i] = std::make_unique<MultiFab>(
+                        Efield_cp[lev][i]->boxArray(), dm, Efield_cp[lev][i]->nComp(), ng);
+                }
+                Etmp[i]->setVal(0.0);
+            }
             // Guard cells may not be up to date beyond ng_FieldGather
             const amrex::IntVect& ng_src = guard_cells.ng_FieldGather;
-            // Copy Efield_aux to the dE MultiFabs, using up to ng_src (=ng_FieldGather) guard
-            // cells from Efield_aux and filling up to ng (=nGrow) guard cells in the dE MultiFabs
-            dEx.ParallelCopy(*Efield_aux[lev-1][0], 0, 0, Efield_aux[lev-1][0]->nComp(), ng_src, ng, crse_period);
-            dEy.ParallelCopy(*Efield_aux[lev-1][1], 0, 0, Efield_aux[lev-1][1]->nComp(), ng_src, ng, crse_period);
-            dEz.ParallelCopy(*Efield_aux[lev-1][2], 0, 0, Efield_aux[lev-1][2]->nComp(), ng_src, ng, crse_period);
-            if (Efield_cax[lev][0])
-            {
-                MultiFab::Copy(*Efield_cax[lev][0], dEx, 0, 0, Efield_cax[lev][0]->nComp(), ng);
-                MultiFab::Copy(*Efield_cax[lev][1], dEy, 0, 0, Efield_cax[lev][1]->nComp(), ng);
-                MultiFab::Copy(*Efield_cax[lev][2], dEz, 0, 0, Efield_cax[lev][2]->nComp(), ng);
+            // Copy Efield_aux to the Etmp MultiFabs, using up to ng_src (=ng_FieldGather) guard
+            // cells from Efield_aux and filling up to ng (=nGrow) guard cells in the Etmp MultiFabs
+            for (int i = 0; i < 3; ++i) {
+                Etmp[i]->ParallelCopy(*Efield_aux[lev-1][i], 0, 0, Efield_aux[lev-1][i]->nComp(), ng_src, ng, crse_period);
             }
-            MultiFab::Subtract(dEx, *Efield_cp[lev][0], 0, 0, Efield_cp[lev][0]->nComp(), ng);
-            MultiFab::Subtract(dEy, *Efield_cp[lev][1], 0, 0, Efield_cp[lev][1]->nComp(), ng);
-            MultiFab::Subtract(dEz, *Efield_cp[lev][2], 0, 0, Efield_cp[lev][2]->nComp(), ng);
 
             const amrex::IntVect& refinement_ratio = refRatio(lev-1);
 
@@ -392,22 +395,25 @@ WarpX::UpdateAuxilaryDataSameType ()
                 Array4<Real const> const& ex_fp = Efield_fp[lev][0]->const_array(mfi);
                 Array4<Real const> const& ey_fp = Efield_fp[lev][1]->const_array(mfi);
                 Array4<Real const> const& ez_fp = Efield_fp[lev][2]->const_array(mfi);
-                Array4<Real const> const& ex_c = dEx.const_array(mfi);
-                Array4<Real const> const& ey_c = dEy.const_array(mfi);
-                Array4<Real const> const& ez_c = dEz.const_array(mfi);
+                Array4<Real const> const& ex_cp = Efield_cp[lev][0]->const_array(mfi);
+                Array4<Real const> const& ey_cp = Efield_cp[lev][1]->const_array(mfi);
+                Array4<Real const> const& ez_cp = Efield_cp[lev][2]->const_array(mfi);
+                Array4<Real const> const& ex_c = Etmp[0]->const_array(mfi);
+                Array4<Real const> const& ey_c = Etmp[1]->const_array(mfi);
+                Array4<Real const> const& ez_c = Etmp[2]->const_array(mfi);
 
                 amrex::ParallelFor(Box(ex_aux), Box(ey_aux), Box(ez_aux),
                 [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
                 {
-                    warpx_interp(j, k, l, ex_aux, ex_fp, ex_c, Ex_stag, refinement_ratio);
+                    warpx_interp(j, k, l, ex_aux, ex_fp, ex_c, ex_cp, Ex_stag, refinement_ratio);
                 },
                 [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
                 {
-                    warpx_interp(j, k, l, ey_aux, ey_fp, ey_c, Ey_stag, refinement_ratio);
+                    warpx_interp(j, k, l, ey_aux, ey_fp, ey_c, ey_cp, Ey_stag, refinement_ratio);
                 },
                 [=] AMREX_GPU_DEVICE (int j, int k, int l) noexcept
                 {
-                    warpx_interp(j, k, l, ez_aux, ez_fp, ez_c, Ez_stag, refinement_ratio);
+                    warpx_interp(j, k, l, ez_aux, ez_fp, ez_c, ez_cp, Ez_stag, refinement_ratio);
                 });
             }
         }
@@ -540,6 +546,8 @@ WarpX::FillBoundaryE(int lev, IntVect ng)
 void
 WarpX::FillBoundaryE (int lev, PatchType patch_type, IntVect ng)
 {
+    StepTimers::Scope step_timer(StepTimers::Communication);
+
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev]->ok())
@@ -602,6 +610,8 @@ WarpX::FillBoundaryB (int lev, IntVect ng)
 void
 WarpX::FillBoundaryB (int lev, PatchType patch_type, IntVect ng)
 {
+    StepTimers::Scope step_timer(StepTimers::Communication);
+
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev]->ok())
@@ -662,6 +672,8 @@ WarpX::FillBoundaryE_avg(int lev, IntVect ng)
 void
 WarpX::FillBoundaryE_avg (int lev, PatchType patch_type, IntVect ng)
 {
+    StepTimers::Scope step_timer(StepTimers::Communication);
+
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev]->ok())
@@ -716,6 +728,8 @@ WarpX::FillBoundaryB_avg (int lev, IntVect ng)
 void
 WarpX::FillBoundaryB_avg (int lev, PatchType patch_type, IntVect ng)
 {
+    StepTimers::Scope step_timer(StepTimers::Communication);
+
     if (patch_type == PatchType::fine)
     {
         if (do_pml && pml[lev]->ok())
@@ -767,6 +781,8 @@ WarpX::FillBoundaryF (int lev, IntVect ng)
 void
 WarpX::FillBoundaryF (int lev, PatchType patch_type, IntVect ng)
 {
+    StepTimers::Scope step_timer(StepTimers::Communication);
+
     if (patch_type == PatchType::fine && F_fp[lev])
     {
         if (do_pml && pml[lev]->ok())
@@ -819,6 +835,8 @@ void WarpX::FillBoundaryG (int lev, IntVect ng)
 
 void WarpX::FillBoundaryG (int lev, PatchType patch_type, IntVect ng)
 {
+    StepTimers::Scope step_timer(StepTimers::Communication);
+
     if (patch_type == PatchType::fine && G_fp[lev])
     {
         // TODO Exchange in PML cells will go here
@@ -869,6 +887,8 @@ WarpX::FillBoundaryAux (IntVect ng)
 void
 WarpX::FillBoundaryAux (int lev, IntVect ng)
 {
+    StepTimers::Scope step_timer(StepTimers::Communication);
+
     const auto& period = Geom(lev).periodicity();
     Efield_aux[lev][0]->FillBoundary(ng, period);
     Efield_aux[lev][1]->FillBoundary(ng, period);
@@ -882,6 +902,7 @@ void
 WarpX::SyncCurrent ()
 {
     WARPX_PROFILE("WarpX::SyncCurrent()");
+    StepTimers::Scope step_timer(StepTimers::Communication);
 
     // If warpx.do_current_centering = 1, center currents from nodal grid to staggered grid
     if (WarpX::do_current_centering)
@@ -928,6 +949,7 @@ void
 WarpX::SyncRho ()
 {
     WARPX_PROFILE("WarpX::SyncRho()");
+    StepTimers::Scope step_timer(StepTimers::Communication);
 
     if (!rho_fp[0]) return;
     const int ncomp = rho_fp[0]->nComp();
@@ -1241,6 +1263,8 @@ void WarpX::NodalSyncPML (int lev)
 
 void WarpX::NodalSyncPML (int lev, PatchType patch_type)
 {
+    StepTimers::Scope step_timer(StepTimers::Communication);
+
     if (pml[lev]->ok())
     {
         const auto& pml_E = (patch_type == PatchType::fine) ? pml[lev]->GetE_fp() : pml[lev]->GetE_cp();
@@ -1282,6 +1306,8 @@ void WarpX::NodalSyncE (int lev)
 
 void WarpX::NodalSyncE (int lev, PatchType patch_type)
 {
+    StepTimers::Scope step_timer(StepTimers::Communication);
+
     if (patch_type == PatchType::fine)
     {
         const auto& period = Geom(lev).periodicity();
@@ -1315,6 +1341,8 @@ void WarpX::NodalSyncB (int lev)
 
 void WarpX::NodalSyncB (int lev, PatchType patch_type)
 {
+    StepTimers::Scope step_timer(StepTimers::Communication);
+
     if (patch_type == PatchType::fine)
     {
         const auto& period = Geom(lev).periodicity();
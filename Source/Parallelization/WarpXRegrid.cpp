@@ -9,8 +9,11 @@
 #include "WarpX.H"
 
 #include "Diagnostics/MultiDiagnostics.H"
+#include "Diagnostics/ReducedDiags/MemoryUsage.H"
+#include "FieldSolver/FiniteDifferenceSolver/MacroscopicProperties/MacroscopicProperties.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
+#include "Utils/StepTimers.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
@@ -18,6 +21,7 @@
 #include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FabFactory.H>
@@ -30,6 +34,7 @@
 #include <AMReX_ParIter.H>
 #include <AMReX_ParallelContext.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Vector.H>
 #include <AMReX_iMultiFab.H>
@@ -39,6 +44,8 @@
 #include <cmath>
 #include <cstddef>
 #include <memory>
+#include <numeric>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -49,6 +56,7 @@ WarpX::LoadBalance ()
 {
     WARPX_PROFILE_REGION("LoadBalance");
     WARPX_PROFILE("WarpX::LoadBalance()");
+    StepTimers::Scope step_timer(StepTimers::LoadBalance);
 
     AMREX_ALWAYS_ASSERT(costs[0] != nullptr);
 
@@ -66,6 +74,13 @@ WarpX::LoadBalance ()
     const int nLevels = finestLevel();
     for (int lev = 0; lev <= nLevels; ++lev)
     {
+        // Try first to split the most expensive boxes and merge the cheapest ones
+        if (load_balance_rechop && LoadBalanceRechop(lev))
+        {
+            loadBalancedAnyLevel = true;
+            continue;
+        }
+
         int doLoadBalance = false;
 
         // Compute the new distribution mapping
@@ -134,6 +149,190 @@ WarpX::LoadBalance ()
 }
 
 
+bool
+WarpX::LoadBalanceRechop (int lev)
+{
+    WARPX_PROFILE("WarpX::LoadBalanceRechop()");
+
+    const BoxArray& ba = boxArray(lev);
+    const DistributionMapping& dm = DistributionMap(lev);
+    const int nboxes = ba.size();
+    const int nprocs = ParallelContext::NProcsSub();
+
+    // Gather the costs of all boxes on all ranks
+    Vector<Real> box_costs(nboxes, 0.0_rt);
+    for (int i : costs[lev]->IndexArray())
+    {
+        box_costs[i] = (*costs[lev])[i];
+    }
+    ParallelAllReduce::Sum(box_costs.data(), nboxes, ParallelContext::CommunicatorSub());
+
+    const Real total_cost = std::accumulate(box_costs.begin(), box_costs.end(), 0.0_rt);
+    if (total_cost <= 0.0_rt) return false;
+
+    // Efficiency of the current distribution mapping (average over max cost per rank)
+    Vector<Real> rank_costs(nprocs, 0.0_rt);
+    for (int i = 0; i < nboxes; ++i)
+    {
+        rank_costs[dm[i]] += box_costs[i];
+    }
+    const Real currentEfficiency = total_cost / nprocs
+        / *std::max_element(rank_costs.begin(), rank_costs.end());
+
+    // Boxes created by the last re-chop of this level are left unchanged for a few
+    // load balances, so that the same boxes are not split and merged back repeatedly
+    if (static_cast<int>(m_rechop_frozen_boxes.size()) <= lev)
+    {
+        m_rechop_frozen_boxes.resize(lev+1);
+        m_rechop_cooldown_left.resize(lev+1, 0);
+    }
+    std::set<Box> const& frozen_boxes = m_rechop_frozen_boxes[lev];
+    const bool use_frozen_boxes = (m_rechop_cooldown_left[lev] > 0);
+    if (use_frozen_boxes) --m_rechop_cooldown_left[lev];
+
+    // The target cost per box is such that each rank gets several boxes
+    const Real target_cost = total_cost / nprocs;
+    const IntVect& blocking_factor = blockingFactor(lev);
+    const IntVect& max_grid_size = maxGridSize(lev);
+
+    // Split the boxes whose cost exceeds load_balance_rechop_split_factor times the target cost,
+    // along their longest direction and in pieces aligned with the blocking factor;
+    // the cost of each piece is estimated from its number of cells
+    bool changed = false;
+    BoxList new_boxes;
+    Vector<Real> new_costs;
+    Vector<Box> merge_candidates;
+    Vector<Real> merge_candidate_costs;
+    for (int i = 0; i < nboxes; ++i)
+    {
+        Box bx = ba[i];
+        const Real cost_per_cell = box_costs[i] / bx.d_numPts();
+        if (use_frozen_boxes && frozen_boxes.count(bx) > 0)
+        {
+            new_boxes.push_back(bx);
+            new_costs.push_back(box_costs[i]);
+        }
+        else if (box_costs[i] > load_balance_rechop_split_factor * target_cost)
+        {
+            Vector<Box> pieces{bx};
+            Real piece_cost = box_costs[i];
+            while (piece_cost > load_balance_rechop_split_factor * target_cost)
+            {
+                Vector<Box> split_pieces;
+                for (Box& piece : pieces)
+                {
+                    int dir = 0;
+                    const int len = piece.longside(dir);
+                    if (len >= 2*blocking_factor[dir])
+                    {
+                        const int half = (len / 2 / blocking_factor[dir]) * blocking_factor[dir];
+                        split_pieces.push_back(piece.chop(dir, piece.smallEnd(dir) + half));
+                    }
+                    split_pieces.push_back(piece);
+                }
+                if (split_pieces.size() == pieces.size()) break; // pieces cannot be split further
+                pieces = split_pieces;
+                piece_cost = 0.0_rt;
+                for (Box const& piece : pieces)
+                {
+                    piece_cost = std::max(piece_cost, static_cast<Real>(cost_per_cell * piece.d_numPts()));
+                }
+            }
+            changed = changed || (pieces.size() > 1);
+            for (Box const& piece : pieces)
+            {
+                new_boxes.push_back(piece);
+                new_costs.push_back(cost_per_cell * piece.d_numPts());
+            }
+        }
+        else if (box_costs[i] < load_balance_rechop_merge_factor * target_cost)
+        {
+            merge_candidates.push_back(bx);
+            merge_candidate_costs.push_back(box_costs[i]);
+        }
+        else
+        {
+            new_boxes.push_back(bx);
+            new_costs.push_back(box_costs[i]);
+        }
+    }
+
+    // Merge pairs of cheap boxes whose union is a box no larger than max_grid_size
+    // and whose cost remains below the merge threshold
+    const int ncandidates = merge_candidates.size();
+    Vector<int> merged(ncandidates, 0);
+    for (int i = 0; i < ncandidates; ++i)
+    {
+        if (merged[i]) continue;
+        for (int j = i+1; j < ncandidates; ++j)
+        {
+            if (merged[j]) continue;
+            const Real cost = merge_candidate_costs[i] + merge_candidate_costs[j];
+            if (cost >= load_balance_rechop_merge_factor * target_cost) continue;
+            const Box bx = amrex::minBox(merge_candidates[i], merge_candidates[j]);
+            if (bx.numPts() != merge_candidates[i].numPts() + merge_candidates[j].numPts()) continue;
+            if (!bx.length().allLE(max_grid_size)) continue;
+            merge_candidates[i] = bx;
+            merge_candidate_costs[i] = cost;
+            merged[j] = 1;
+            changed = true;
+        }
+        new_boxes.push_back(merge_candidates[i]);
+        new_costs.push_back(merge_candidate_costs[i]);
+    }
+
+    if (!changed) return false;
+    BoxArray new_ba(std::move(new_boxes));
+
+    // Compute the distribution mapping of the new BoxArray from the estimated costs;
+    // this is done identically on all ranks, since all of them have all the costs
+    const int nmax = static_cast<int>(std::ceil(
+        static_cast<Real>(new_ba.size())/nprocs*load_balance_knapsack_factor));
+    Real proposedEfficiency = 0.0_rt;
+    const DistributionMapping new_dm = (load_balance_with_sfc)
+        ? DistributionMapping::makeSFC(new_costs, new_ba, proposedEfficiency)
+        : DistributionMapping::makeKnapSack(new_costs, proposedEfficiency, nmax);
+
+    // The proposed efficiency is estimated, not measured: compare it with the efficiency
+    // estimated in the same way for a new distribution mapping of the current boxes,
+    // which the usual load balancing would adopt instead
+    const int nmax_current = static_cast<int>(std::ceil(
+        static_cast<Real>(nboxes)/nprocs*load_balance_knapsack_factor));
+    Real baselineEfficiency = 0.0_rt;
+    if (load_balance_with_sfc) {
+        DistributionMapping::makeSFC(box_costs, ba, baselineEfficiency);
+    } else {
+        DistributionMapping::makeKnapSack(box_costs, baselineEfficiency, nmax_current);
+    }
+
+    if (proposedEfficiency <= load_balance_efficiency_ratio_threshold*currentEfficiency) return false;
+    if (proposedEfficiency <= (1.0_rt + load_balance_rechop_margin)*baselineEfficiency) return false;
+
+    if (verbose)
+    {
+        amrex::Print() << "Load balance: level " << lev << " re-chopped from " << nboxes
+                       << " to " << new_ba.size() << " boxes (estimated efficiency "
+                       << baselineEfficiency << " -> " << proposedEfficiency << ")\n";
+    }
+
+    // Freeze the boxes that were created by this re-chop, i.e. the split and merged ones
+    std::set<Box> old_boxes;
+    for (int i = 0; i < nboxes; ++i) old_boxes.insert(ba[i]);
+    m_rechop_frozen_boxes[lev].clear();
+    for (int i = 0; i < new_ba.size(); ++i)
+    {
+        if (old_boxes.count(new_ba[i]) == 0) m_rechop_frozen_boxes[lev].insert(new_ba[i]);
+    }
+    m_rechop_cooldown_left[lev] = load_balance_rechop_cooldown;
+
+    RemakeLevel(lev, t_new[lev], new_ba, new_dm);
+
+    // Record the load balance efficiency
+    setLoadBalanceEfficiency(lev, proposedEfficiency);
+
+    return true;
+}
+
 void
 WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const DistributionMapping& dm)
 {
@@ -413,10 +612,90 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
 
     } else
     {
-        amrex::Abort("RemakeLevel: to be implemented");
+        // The BoxArray of this level changes (e.g., the grids are chopped differently), but it
+        // must still cover the same region: the MultiFabs of this level are re-allocated on the
+        // new BoxArray, and the fields that are carried from one step to the next are copied over.
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(ba.contains(boxArray(lev)) && boxArray(lev).contains(ba),
+            "RemakeLevel: the new BoxArray must cover the same region as the old one");
+
+        std::array<std::unique_ptr<MultiFab>,3> old_Efield_fp;
+        std::array<std::unique_ptr<MultiFab>,3> old_Bfield_fp;
+        std::array<std::unique_ptr<MultiFab>,3> old_Efield_cp;
+        std::array<std::unique_ptr<MultiFab>,3> old_Bfield_cp;
+        for (int idim = 0; idim < 3; ++idim)
+        {
+            old_Efield_fp[idim] = std::move(Efield_fp[lev][idim]);
+            old_Bfield_fp[idim] = std::move(Bfield_fp[lev][idim]);
+            old_Efield_cp[idim] = std::move(Efield_cp[lev][idim]);
+            old_Bfield_cp[idim] = std::move(Bfield_cp[lev][idim]);
+        }
+        std::unique_ptr<MultiFab> old_F_fp = std::move(F_fp[lev]);
+        std::unique_ptr<MultiFab> old_G_fp = std::move(G_fp[lev]);
+        std::unique_ptr<MultiFab> old_F_cp = std::move(F_cp[lev]);
+        std::unique_ptr<MultiFab> old_G_cp = std::move(G_cp[lev]);
+
+        ClearLevel(lev);
+        SetBoxArray(lev, ba);
+        SetDistributionMap(lev, dm);
+        AllocLevelData(lev, ba, dm);
+
+#ifdef AMREX_USE_EB
+        ComputeEdgeLengths();
+        ComputeFaceAreas();
+        ScaleEdges();
+        ScaleAreas();
+        ComputeDistanceToEB();
+#endif
+
+        // Copy the valid cells of the old MultiFabs to the new ones; guard cells are
+        // filled from the valid cells of neighboring boxes, and set to 0 elsewhere
+        // (they are updated with FillBoundary in the PIC loop anyway).
+        const amrex::Periodicity& period = Geom(lev).periodicity();
+        const amrex::Periodicity& cperiod = (lev > 0) ? Geom(lev-1).periodicity() : period;
+        auto const copy_fields = [] (std::unique_ptr<MultiFab>& dst, std::unique_ptr<MultiFab> const& src,
+                                     const amrex::Periodicity& periodicity)
+        {
+            if (dst == nullptr || src == nullptr) return;
+            dst->setVal(0.0);
+            dst->ParallelCopy(*src, 0, 0, src->nComp(), IntVect(0), dst->nGrowVect(), periodicity);
+        };
+        for (int idim = 0; idim < 3; ++idim)
+        {
+            copy_fields(Efield_fp[lev][idim], old_Efield_fp[idim], period);
+            copy_fields(Bfield_fp[lev][idim], old_Bfield_fp[idim], period);
+            copy_fields(Efield_cp[lev][idim], old_Efield_cp[idim], cperiod);
+            copy_fields(Bfield_cp[lev][idim], old_Bfield_cp[idim], cperiod);
+        }
+        copy_fields(F_fp[lev], old_F_fp, period);
+        copy_fields(G_fp[lev], old_G_fp, period);
+        copy_fields(F_cp[lev], old_F_cp, cperiod);
+        copy_fields(G_cp[lev], old_G_cp, cperiod);
+
+        // the memory usage peaks here, as the old fields are not freed yet
+        MemoryUsage::Sample();
+
+        if (current_buffer_masks[lev] || gather_buffer_masks[lev])
+            BuildBufferMasks();
+
+        if (costs[lev] != nullptr)
+        {
+            for (int i : costs[lev]->IndexArray())
+            {
+                (*costs[lev])[i] = 0.0;
+            }
+            setLoadBalanceEfficiency(lev, -1);
+        }
+
+        // The macroscopic properties are defined on the BoxArray of level 0
+        if (lev == 0 && WarpX::em_solver_medium == MediumForEM::Macroscopic) {
+            m_macroscopic_properties->InitData();
+        }
     }
     // Re-initialize diagnostic functors that stores pointers to the user-requested fields at level, lev.
     multi_diags->InitializeFieldFunctors( lev );
+
+    // record the memory usage on the new grids
+    MemoryUsage::Sample();
 }
 
 void
@@ -5,6 +5,7 @@
  * License: BSD-3-Clause-LBNL
  */
 #include "BackgroundMCCCollision.H"
+#include "CollisionCellBins.H"
 #include "MCCScattering.H"
 #include "Particles/ParticleCreation/FilterCopyTransform.H"
 #include "Particles/ParticleCreation/SmartCopy.H"
@@ -17,6 +18,10 @@
 #include <AMReX_REAL.H>
 #include <AMReX_Vector.H>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
 #include <string>
 
 BackgroundMCCCollision::BackgroundMCCCollision (std::string const collision_name)
@@ -83,6 +88,60 @@ BackgroundMCCCollision::BackgroundMCCCollision (std::string const collision_name
         }
     }
 
+    // the cross-sections are either interpolated directly from the input data,
+    // which requires equally spaced energies, or resampled on a common
+    // logarithmic energy grid, so that the interpolation index is computed
+    // once per particle for all the processes
+    std::string cross_section_grid = "uniform";
+    pp.query("cross_section_grid", cross_section_grid);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
+        cross_section_grid == "uniform" || cross_section_grid == "log",
+        "cross_section_grid must be either uniform or log");
+    m_log_grid = (cross_section_grid == "log");
+
+    if (m_log_grid) {
+        int npoints = 1024;
+        queryWithParser(pp, "cross_section_points", npoints);
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(npoints > 1,
+                                         "cross_section_points must be larger than 1");
+
+        // the grid covers the energy range of all processes
+        m_log_energy_lo = std::numeric_limits<amrex::Real>::max();
+        m_log_energy_hi = 0;
+        for (auto const* processes : {&m_scattering_processes, &m_ionization_processes}) {
+            for (auto const& p : *processes) {
+                m_log_energy_lo = std::min(m_log_energy_lo, p.smallestPositiveEnergy());
+                m_log_energy_hi = std::max(m_log_energy_hi, p.largestEnergy());
+            }
+        }
+        for (auto* processes : {&m_scattering_processes, &m_ionization_processes}) {
+            for (auto& p : *processes) {
+                p.resampleLogGrid(m_log_energy_lo, m_log_energy_hi, npoints);
+            }
+        }
+        m_log_grid_size = npoints;
+
+        const auto n_processes = m_scattering_processes.size();
+        amrex::Gpu::HostVector<amrex::Real> h_scattering_sigmas(npoints * n_processes);
+        for (std::size_t ip = 0; ip < n_processes; ++ip) {
+            auto const& sigmas = m_scattering_processes[ip].tabulatedCrossSection();
+            for (int ie = 0; ie < npoints; ++ie) {
+                h_scattering_sigmas[ie*n_processes + ip] = sigmas[ie];
+            }
+        }
+        m_scattering_sigmas.resize(h_scattering_sigmas.size());
+        amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, h_scattering_sigmas.begin(),
+                              h_scattering_sigmas.end(), m_scattering_sigmas.begin());
+        amrex::Gpu::streamSynchronize();
+    } else {
+        for (auto const* processes : {&m_scattering_processes, &m_ionization_processes}) {
+            for (auto const& p : *processes) {
+                AMREX_ALWAYS_ASSERT_WITH_MESSAGE(p.hasUniformEnergyGrid(),
+                    "Energy grid not evenly spaced: use cross_section_grid = log to resample the cross-sections.");
+            }
+        }
+    }
+
 #ifdef AMREX_USE_GPU
     amrex::Gpu::HostVector<MCCProcess::Executor> h_scattering_processes_exe;
     amrex::Gpu::HostVector<MCCProcess::Executor> h_ionization_processes_exe;
@@ -238,6 +297,7 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
 
     // So that CUDA code gets its intrinsic, not the host-only C++ library version
     using std::sqrt;
+    using std::log;
 
     // get particle count
     const long np = pti.numParticles();
@@ -255,6 +315,16 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
     auto scattering_processes = m_scattering_processes_exe.data();
     int const process_count   = m_scattering_processes_exe.size();
 
+    // cross-sections interleaved on the logarithmic energy grid, if used
+    bool const log_grid = m_log_grid;
+    amrex::Real const* const AMREX_RESTRICT scattering_sigmas = m_scattering_sigmas.dataPtr();
+    int const log_grid_size = m_log_grid_size;
+    amrex::Real const log_energy_lo = std::log(m_log_energy_lo > 0 ? m_log_energy_lo : 1._rt);
+    amrex::Real const inv_dlogE = log_grid ?
+        (log_grid_size - 1) / (std::log(m_log_energy_hi) - log_energy_lo) : 0._rt;
+    amrex::Real const energy_lo = m_log_energy_lo;
+    amrex::Real const energy_hi = m_log_energy_hi;
+
     amrex::Real total_collision_prob = m_total_collision_prob;
     amrex::Real nu_max = m_nu_max;
 
@@ -310,12 +380,38 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
                               }
                               v_coll = sqrt(v_coll2);
 
+                              // on the logarithmic grid, the bounding energy pairs are
+                              // the same for all collision pathways
+                              int idx_1 = 0, idx_2 = 0;
+                              amrex::Real frac = 0;
+                              if (log_grid) {
+                                  if (E_coll >= energy_hi) {
+                                      idx_1 = idx_2 = log_grid_size - 1;
+                                  } else if (E_coll > energy_lo) {
+                                      amrex::Real temp = (log(E_coll) - log_energy_lo) * inv_dlogE;
+                                      idx_1 = amrex::min(static_cast<int>(temp), log_grid_size - 1);
+                                      idx_2 = amrex::min(idx_1 + 1, log_grid_size - 1);
+                                      frac = temp - idx_1;
+                                  }
+                              }
+
                               // loop through all collision pathways
                               for (int i = 0; i < process_count; i++) {
                                   auto const& scattering_process = *(scattering_processes + i);
 
                                   // get collision cross-section
-                                  sigma_E = scattering_process.getCrossSection(E_coll);
+                                  if (log_grid) {
+                                      if (scattering_process.m_energy_penalty > 0 &&
+                                          E_coll <= scattering_process.m_energy_penalty) {
+                                          sigma_E = 0;
+                                      } else {
+                                          amrex::Real const sigma_1 = scattering_sigmas[idx_1*process_count + i];
+                                          amrex::Real const sigma_2 = scattering_sigmas[idx_2*process_count + i];
+                                          sigma_E = sigma_1 + (sigma_2 - sigma_1) * frac;
+                                      }
+                                  } else {
+                                      sigma_E = scattering_process.getCrossSection(E_coll);
+                                  }
 
                                   // calculate normalized collision frequency
                                   nu_i += n_a * sigma_E * v_coll / nu_max;
@@ -402,4 +498,8 @@ void BackgroundMCCCollision::doBackgroundIonization
         setNewParticleIDs(elec_tile, np_elec, num_added);
         setNewParticleIDs(ion_tile, np_ion, num_added);
     }
+
+    // The binary collisions that follow must bin the new particles
+    CollisionCellBins::Invalidate(species1);
+    CollisionCellBins::Invalidate(species2);
 }
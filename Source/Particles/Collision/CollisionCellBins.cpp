@@ -0,0 +1,58 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "CollisionCellBins.H"
+
+#include "Utils/ParticleUtils.H"
+
+#include <AMReX_IntVect.H>
+#include <AMReX_MFIter.H>
+
+std::map<CollisionCellBins::Key, CollisionCellBins::Entry> CollisionCellBins::m_bins;
+
+CollisionCellBins::ParticleBins&
+CollisionCellBins::Get (WarpXParticleContainer& pc, int lev, amrex::MFIter const& mfi)
+{
+    const Key key{&pc, lev, mfi.index(), mfi.LocalTileIndex()};
+
+    // Inserting in the map does not invalidate the other entries,
+    // which may be in use by other threads
+    Entry* entry = nullptr;
+#ifdef AMREX_USE_OMP
+#pragma omp critical (collision_cell_bins)
+#endif
+    {
+        entry = &m_bins[key];
+    }
+
+    auto& ptile = pc.ParticlesAt(lev, mfi);
+    const amrex::Box tilebox = mfi.tilebox(amrex::IntVect::TheZeroVector());
+    if (entry->np != ptile.numParticles() || entry->tilebox != tilebox)
+    {
+        entry->bins = ParticleUtils::findParticlesInEachCell(lev, mfi, ptile);
+        entry->tilebox = tilebox;
+        entry->np = ptile.numParticles();
+    }
+    return entry->bins;
+}
+
+void
+CollisionCellBins::Clear ()
+{
+    m_bins.clear();
+}
+
+void
+CollisionCellBins::Invalidate (WarpXParticleContainer const& pc)
+{
+    for (auto it = m_bins.begin(); it != m_bins.end(); ) {
+        if (std::get<0>(it->first) == &pc) {
+            it = m_bins.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
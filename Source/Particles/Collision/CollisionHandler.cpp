@@ -7,6 +7,7 @@
 #include "CollisionHandler.H"
 
 #include "BinaryCollision.H"
+#include "CollisionCellBins.H"
 #include "PairWiseCoulombCollisionFunc.H"
 #include "BackgroundMCCCollision.H"
 
@@ -62,4 +63,7 @@ void CollisionHandler::doCollisions ( amrex::Real cur_time, MultiParticleContain
         collision->doCollisions(cur_time, mypc);
     }
 
+    // The cell binning of the particles is shared by the collisions of this step only
+    CollisionCellBins::Clear();
+
 }
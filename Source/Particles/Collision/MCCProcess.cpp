@@ -7,6 +7,10 @@
 #include "MCCProcess.H"
 #include "WarpX.H"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
 MCCProcess::MCCProcess (
                         const std::string& scattering_process,
                         const std::string& cross_section_file,
@@ -37,31 +41,40 @@ MCCProcess::MCCProcess (
 void
 MCCProcess::init (const std::string& scattering_process, const amrex::Real energy)
 {
+    m_input_sigmas.assign(m_sigmas_h.begin(), m_sigmas_h.end());
     m_exe_h.m_sigmas_data = m_sigmas_h.data();
 
     // save energy grid parameters for easy use
-    m_grid_size = m_energies.size();
+    const int grid_size = m_energies.size();
+    m_exe_h.m_grid_size = grid_size;
     m_exe_h.m_energy_lo = m_energies[0];
-    m_exe_h.m_energy_hi = m_energies[m_grid_size-1];
+    m_exe_h.m_energy_hi = m_energies[grid_size-1];
     m_exe_h.m_sigma_lo = m_sigmas_h[0];
-    m_exe_h.m_sigma_hi = m_sigmas_h[m_grid_size-1];
-    m_exe_h.m_dE = (m_exe_h.m_energy_hi - m_exe_h.m_energy_lo)/(m_grid_size - 1.);
+    m_exe_h.m_sigma_hi = m_sigmas_h[grid_size-1];
+    m_exe_h.m_dE = (m_exe_h.m_energy_hi - m_exe_h.m_energy_lo)/(grid_size - 1.);
     m_exe_h.m_energy_penalty = energy;
     m_exe_h.m_type = parseProcessType(scattering_process);
 
-    // sanity check cross-section energy grid
-    sanityCheckEnergyGrid(m_energies, m_exe_h.m_dE);
+    // the direct linear interpolation requires equal energy steps, otherwise
+    // the cross-section must be resampled (see resampleLogGrid)
+    m_uniform_grid = isUniformEnergyGrid(m_energies, m_exe_h.m_dE);
 
     // check that the cross-section is 0 at the energy cost if the energy
     // cost is > 0 - this is to prevent the possibility of negative left
     // over energy after a collision event
     if (m_exe_h.m_energy_penalty > 0) {
         AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
-            (getCrossSection(m_exe_h.m_energy_penalty) == 0),
+            (interpolateInput(m_exe_h.m_energy_penalty) == 0),
             "Cross-section > 0 at energy cost for collision."
         );
     }
 
+    copyToDevice();
+}
+
+void
+MCCProcess::copyToDevice ()
+{
 #ifdef AMREX_USE_GPU
     m_exe_d = m_exe_h;
     m_sigmas_d.resize(m_sigmas_h.size());
@@ -72,6 +85,56 @@ MCCProcess::init (const std::string& scattering_process, const amrex::Real energ
 #endif
 }
 
+amrex::Real
+MCCProcess::interpolateInput (amrex::Real E_coll) const
+{
+    if (E_coll <= m_energies.front()) return m_input_sigmas.front();
+    if (E_coll >= m_energies.back()) return m_input_sigmas.back();
+
+    // first energy of the grid larger than E_coll
+    const auto it = std::upper_bound(m_energies.begin(), m_energies.end(), E_coll);
+    const auto i2 = static_cast<std::size_t>(it - m_energies.begin());
+    const auto i1 = i2 - 1;
+    const amrex::Real frac = (E_coll - m_energies[i1]) / (m_energies[i2] - m_energies[i1]);
+    return m_input_sigmas[i1] + (m_input_sigmas[i2] - m_input_sigmas[i1]) * frac;
+}
+
+amrex::Real
+MCCProcess::smallestPositiveEnergy () const
+{
+    const auto it = std::upper_bound(m_energies.begin(), m_energies.end(), amrex::Real(0.));
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(it != m_energies.end(),
+        "Cross-section energy grid has no positive energy.");
+    return *it;
+}
+
+void
+MCCProcess::resampleLogGrid (amrex::Real energy_lo, amrex::Real energy_hi, int npoints)
+{
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(energy_lo > 0 && energy_hi > energy_lo && npoints > 1,
+        "Invalid logarithmic energy grid for the cross-section.");
+
+    const amrex::Real log_lo = std::log(energy_lo);
+    const amrex::Real dlogE = (std::log(energy_hi) - log_lo) / (npoints - 1);
+
+    m_sigmas_h.resize(npoints);
+    for (int i = 0; i < npoints; ++i) {
+        m_sigmas_h[i] = interpolateInput(std::exp(log_lo + i*dlogE));
+    }
+
+    m_exe_h.m_sigmas_data = m_sigmas_h.data();
+    m_exe_h.m_log_grid = true;
+    m_exe_h.m_grid_size = npoints;
+    m_exe_h.m_energy_lo = energy_lo;
+    m_exe_h.m_energy_hi = energy_hi;
+    m_exe_h.m_sigma_lo = m_sigmas_h[0];
+    m_exe_h.m_sigma_hi = m_sigmas_h[npoints-1];
+    m_exe_h.m_log_energy_lo = log_lo;
+    m_exe_h.m_inv_dlogE = 1._rt / dlogE;
+
+    copyToDevice();
+}
+
 MCCProcessType
 MCCProcess::parseProcessType(const std::string& scattering_process)
 {
@@ -107,18 +170,16 @@ MCCProcess::readCrossSectionFile (
     );
 }
 
-void
-MCCProcess::sanityCheckEnergyGrid (
-                                   const amrex::Vector<amrex::Real>& energies,
-                                   amrex::Real dE
-                                   )
+bool
+MCCProcess::isUniformEnergyGrid (
+                                 const amrex::Vector<amrex::Real>& energies,
+                                 amrex::Real dE
+                                 )
 {
-    // confirm that the input data for the cross-section was provided with
-    // equal energy steps, otherwise the linear interpolation will fail
+    // check whether the input data for the cross-section was provided with
+    // equal energy steps
     for (unsigned i = 1; i < energies.size(); i++) {
-        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(
-                                         (std::abs(energies[i] - energies[i-1] - dE) < dE / 100.0),
-                                         "Energy grid not evenly spaced."
-                                         );
+        if (std::abs(energies[i] - energies[i-1] - dE) >= dE / 100.0) return false;
     }
+    return true;
 }
@@ -29,6 +29,12 @@ IonizationFilterFunc::IonizationFilterFunc (const WarpXParIter& a_pti, int lev,
                                             const amrex::Real* const AMREX_RESTRICT a_adk_prefactor,
                                             const amrex::Real* const AMREX_RESTRICT a_adk_exp_prefactor,
                                             const amrex::Real* const AMREX_RESTRICT a_adk_power,
+                                            const amrex::Real* const AMREX_RESTRICT a_adk_table,
+                                            const amrex::Real* const AMREX_RESTRICT a_adk_field_min,
+                                            const amrex::Real* const AMREX_RESTRICT a_adk_field_max,
+                                            const amrex::Real* const AMREX_RESTRICT a_adk_log_field_min,
+                                            const amrex::Real* const AMREX_RESTRICT a_adk_inv_dlog_field,
+                                            int a_adk_table_points,
                                             int a_comp,
                                             int a_atomic_number,
                                             int a_offset) noexcept
@@ -37,6 +43,12 @@ IonizationFilterFunc::IonizationFilterFunc (const WarpXParIter& a_pti, int lev,
     m_adk_prefactor = a_adk_prefactor;
     m_adk_exp_prefactor = a_adk_exp_prefactor;
     m_adk_power = a_adk_power;
+    m_adk_table = a_adk_table;
+    m_adk_field_min = a_adk_field_min;
+    m_adk_field_max = a_adk_field_max;
+    m_adk_log_field_min = a_adk_log_field_min;
+    m_adk_inv_dlog_field = a_adk_inv_dlog_field;
+    m_adk_table_points = a_adk_table_points;
     comp = a_comp;
     m_atomic_number = a_atomic_number;
 
@@ -26,9 +26,9 @@ GetExternalEField::GetExternalEField (const WarpXParIter& a_pti, int a_offset) n
         m_type = Parser;
         m_time = warpx.gett_new(a_pti.GetLevel());
         m_get_position = GetParticlePosition(a_pti, a_offset);
-        m_xfield_partparser = mypc.m_Ex_particle_parser->compile<4>();
-        m_yfield_partparser = mypc.m_Ey_particle_parser->compile<4>();
-        m_zfield_partparser = mypc.m_Ez_particle_parser->compile<4>();
+        m_xfield_partparser = mypc.m_Ex_particle_exe;
+        m_yfield_partparser = mypc.m_Ey_particle_exe;
+        m_zfield_partparser = mypc.m_Ez_particle_exe;
     }
     else if (mypc.m_E_ext_particle_s=="repeated_plasma_lens")
     {
@@ -68,9 +68,9 @@ GetExternalBField::GetExternalBField (const WarpXParIter& a_pti, int a_offset) n
         m_type = Parser;
         m_time = warpx.gett_new(a_pti.GetLevel());
         m_get_position = GetParticlePosition(a_pti, a_offset);
-        m_xfield_partparser = mypc.m_Bx_particle_parser->compile<4>();
-        m_yfield_partparser = mypc.m_By_particle_parser->compile<4>();
-        m_zfield_partparser = mypc.m_Bz_particle_parser->compile<4>();
+        m_xfield_partparser = mypc.m_Bx_particle_exe;
+        m_yfield_partparser = mypc.m_By_particle_exe;
+        m_zfield_partparser = mypc.m_Bz_particle_exe;
     }
     else if (mypc.m_B_ext_particle_s=="repeated_plasma_lens")
     {
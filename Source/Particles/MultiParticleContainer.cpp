@@ -10,6 +10,7 @@
  * License: BSD-3-Clause-LBNL
  */
 #include "MultiParticleContainer.H"
+#include "Particles/Collision/CollisionCellBins.H"
 #include "Particles/ElementaryProcess/Ionization.H"
 #ifdef WARPX_QED
 #   include "Particles/ElementaryProcess/QEDInternals/BreitWheelerEngineWrapper.H"
@@ -31,6 +32,8 @@
 #include "Particles/RigidInjectedParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "SpeciesPhysicalProperties.H"
+#include "Utils/ParserJIT.H"
+#include "Utils/StepTimers.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #ifdef AMREX_USE_EB
@@ -66,8 +69,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
 #include <limits>
 #include <map>
+#include <random>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -81,6 +90,135 @@ namespace
     {
         Array4< amrex::Real const > const Ex, Ey, Ez, Bx, By, Bz;
     };
+
+#ifdef WARPX_QED
+    /** Header of the files of the QED table cache: a magic string, the version of
+     *  the cache format and the size in bytes of the table data that follows */
+    constexpr char qed_cache_magic[8] = {'W', 'X', 'Q', 'E', 'D', 'T', 'B', 'L'};
+    constexpr std::uint32_t qed_cache_version = 1;
+    constexpr std::size_t qed_cache_header_size =
+        sizeof(qed_cache_magic) + sizeof(std::uint32_t) + sizeof(std::uint64_t);
+
+    /** Path of the file caching a QED lookup table in cache_dir: its name is a
+     *  hash (FNV-1a) of the parameters of the table, of the floating point
+     *  precision and of the versions of the cache format and of PICSAR, so that
+     *  tables generated with other parameters or another PICSAR are not reused */
+    std::string QedTableCacheFile (const std::string& cache_dir, const std::string& prefix,
+                                   const std::vector<double>& params)
+    {
+        std::ostringstream key;
+        key << std::setprecision(17) << qed_cache_version << " " << WarpX::PicsarVersion()
+            << " " << sizeof(amrex::Real);
+        for (const auto p : params) key << " " << p;
+
+        std::uint64_t hash = 14695981039346656037ULL;
+        for (const char c : key.str()) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+
+        std::ostringstream name;
+        name << cache_dir << "/" << prefix << "_"
+             << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+        return name.str();
+    }
+
+    /** Whether the file exists, as seen by the I/O processor */
+    bool IOProcessorFileExists (const std::string& file_name)
+    {
+        int exists = ParallelDescriptor::IOProcessor() ? amrex::FileExists(file_name) : 0;
+        ParallelDescriptor::Bcast(&exists, 1, ParallelDescriptor::IOProcessorNumber());
+        return exists != 0;
+    }
+
+    /** Write the data of a generated table in the cache, through a temporary
+     *  file with a random name so that concurrent runs never read a partially
+     *  written table. A failure only prints a warning, as the table is not
+     *  read back from the cache by this run. */
+    void WriteQedTableCache (const std::string& cache_dir, const std::string& cache_name,
+                             const Vector<char>& data)
+    {
+        if (!amrex::UtilCreateDirectory(cache_dir, 0755)) {
+            amrex::Warning("Could not create the QED table cache directory " + cache_dir);
+            return;
+        }
+
+        const std::uint64_t size = data.size();
+        Vector<char> file_data(qed_cache_header_size + data.size());
+        char* p = file_data.data();
+        std::memcpy(p, qed_cache_magic, sizeof(qed_cache_magic));
+        p += sizeof(qed_cache_magic);
+        std::memcpy(p, &qed_cache_version, sizeof(qed_cache_version));
+        p += sizeof(qed_cache_version);
+        std::memcpy(p, &size, sizeof(size));
+        p += sizeof(size);
+        std::copy(data.begin(), data.end(), p);
+
+        std::random_device rd;
+        std::ostringstream tmp_name;
+        tmp_name << cache_name << ".tmp" << std::hex << rd() << rd();
+
+        if (!WarpXUtilIO::WriteBinaryDataOnFile(tmp_name.str(), file_data)) {
+            amrex::Warning("Could not write the QED table cache file " + tmp_name.str());
+            std::remove(tmp_name.str().c_str());
+            return;
+        }
+        if (std::rename(tmp_name.str().c_str(), cache_name.c_str()) != 0) {
+            amrex::Warning("Could not rename " + tmp_name.str() + " to " + cache_name);
+            std::remove(tmp_name.str().c_str());
+        }
+    }
+
+    /** Read the data of a table from the cache on all the ranks. The table is
+     *  rejected, with a warning, if the header of the file does not match
+     *  (e.g. a file truncated or written by another version of WarpX), in which
+     *  case it should be generated again.
+     *
+     * @return whether the data were read
+     */
+    bool ReadQedTableCache (const std::string& cache_name, Vector<char>& data)
+    {
+        Vector<char> file_data;
+        ParallelDescriptor::ReadAndBcastFile(cache_name, file_data);
+
+        // ReadAndBcastFile appends a null character to the content of the file
+        bool valid = (file_data.size() >= qed_cache_header_size);
+        std::uint32_t version = 0;
+        std::uint64_t size = 0;
+        if (valid) {
+            const char* p = file_data.data();
+            valid = (std::memcmp(p, qed_cache_magic, sizeof(qed_cache_magic)) == 0);
+            p += sizeof(qed_cache_magic);
+            std::memcpy(&version, p, sizeof(version));
+            p += sizeof(version);
+            std::memcpy(&size, p, sizeof(size));
+            const std::uint64_t file_size = file_data.size() - qed_cache_header_size;
+            valid = valid && (version == qed_cache_version) &&
+                (file_size == size || file_size == size + 1);
+        }
+        if (!valid) {
+            if (ParallelDescriptor::IOProcessor()) {
+                amrex::Warning("Invalid QED table cache file " + cache_name +
+                               ", the table is generated again");
+            }
+            return false;
+        }
+
+        const auto begin = file_data.begin() + qed_cache_header_size;
+        data = Vector<char>{begin, begin + size};
+        return true;
+    }
+
+    /** Broadcast the data of a table generated by the I/O processor to all the ranks */
+    void BcastQedTableData (Vector<char>& data)
+    {
+        const int root = ParallelDescriptor::IOProcessorNumber();
+        Long size = data.size();
+        ParallelDescriptor::Bcast(&size, 1, root);
+        data.resize(size);
+        ParallelDescriptor::Bcast(data.data(), size, root);
+    }
+#endif
 }
 
 MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
@@ -195,6 +333,16 @@ MultiParticleContainer::ReadParameters ()
                                     makeParser(str_By_ext_particle_function,{"x","y","z","t"}));
            m_Bz_particle_parser = std::make_unique<amrex::Parser>(
                                     makeParser(str_Bz_ext_particle_function,{"x","y","z","t"}));
+           for (auto const& expr : {str_Bx_ext_particle_function, str_By_ext_particle_function,
+                                  str_Bz_ext_particle_function}) {
+               ParserJIT::compile(expr, {"x","y","z","t"});
+           }
+           m_Bx_particle_exe = compileJITParser<4>(m_Bx_particle_parser.get(),
+                                    str_Bx_ext_particle_function, {"x","y","z","t"});
+           m_By_particle_exe = compileJITParser<4>(m_By_particle_parser.get(),
+                                    str_By_ext_particle_function, {"x","y","z","t"});
+           m_Bz_particle_exe = compileJITParser<4>(m_Bz_particle_parser.get(),
+                                    str_Bz_ext_particle_function, {"x","y","z","t"});
 
         }
 
@@ -220,6 +368,16 @@ MultiParticleContainer::ReadParameters ()
                                     makeParser(str_Ey_ext_particle_function,{"x","y","z","t"}));
            m_Ez_particle_parser = std::make_unique<amrex::Parser>(
                                     makeParser(str_Ez_ext_particle_function,{"x","y","z","t"}));
+           for (auto const& expr : {str_Ex_ext_particle_function, str_Ey_ext_particle_function,
+                                  str_Ez_ext_particle_function}) {
+               ParserJIT::compile(expr, {"x","y","z","t"});
+           }
+           m_Ex_particle_exe = compileJITParser<4>(m_Ex_particle_parser.get(),
+                                    str_Ex_ext_particle_function, {"x","y","z","t"});
+           m_Ey_particle_exe = compileJITParser<4>(m_Ey_particle_parser.get(),
+                                    str_Ey_ext_particle_function, {"x","y","z","t"});
+           m_Ez_particle_exe = compileJITParser<4>(m_Ez_particle_parser.get(),
+                                    str_Ez_ext_particle_function, {"x","y","z","t"});
 
         }
 
@@ -471,6 +629,7 @@ MultiParticleContainer::PushP (int lev, Real dt,
                                const MultiFab& Ex, const MultiFab& Ey, const MultiFab& Ez,
                                const MultiFab& Bx, const MultiFab& By, const MultiFab& Bz)
 {
+    StepTimers::Scope step_timer(StepTimers::PushDeposit);
     for (auto& pc : allcontainers) {
         pc->PushP(lev, dt, Ex, Ey, Ez, Bx, By, Bz);
     }
@@ -580,17 +739,21 @@ MultiParticleContainer::GetChargeDensity (int lev, bool local)
 void
 MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
 {
+    StepTimers::Scope step_timer(StepTimers::Sorting);
     for (auto& pc : allcontainers) {
         pc->SortParticlesByBin(bin_size);
     }
+    CollisionCellBins::Clear();
 }
 
 void
 MultiParticleContainer::Redistribute ()
 {
+    StepTimers::Scope step_timer(StepTimers::Redistribute);
     for (auto& pc : allcontainers) {
         pc->Redistribute();
     }
+    CollisionCellBins::Clear();
 }
 
 void
@@ -604,9 +767,11 @@ MultiParticleContainer::defineAllParticleTiles ()
 void
 MultiParticleContainer::RedistributeLocal (const int num_ghost)
 {
+    StepTimers::Scope step_timer(StepTimers::Redistribute);
     for (auto& pc : allcontainers) {
         pc->Redistribute(0, 0, 0, num_ghost);
     }
+    CollisionCellBins::Clear();
 }
 
 void
@@ -941,6 +1106,7 @@ void
 MultiParticleContainer::doCollisions ( Real cur_time )
 {
     WARPX_PROFILE("MultiParticleContainer::doCollisions()");
+    StepTimers::Scope step_timer(StepTimers::Collisions);
     collisionhandler->doCollisions(cur_time, this);
 }
 
@@ -1127,8 +1293,10 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     ParmParse pp_qed_qs("qed_qs");
     std::string table_name;
     pp_qed_qs.query("save_table_in", table_name);
-    if(table_name.empty())
-        amrex::Abort("qed_qs.save_table_in should be provided!");
+    std::string cache_dir;
+    pp_qed_qs.query("table_cache_dir", cache_dir);
+    if(table_name.empty() && cache_dir.empty())
+        amrex::Abort("qed_qs.save_table_in or qed_qs.table_cache_dir should be provided!");
 
     // qs_minimum_chi_part is the minimum chi parameter to be
     // considered for Synchrotron emission. If a lepton has chi < chi_min,
@@ -1136,70 +1304,100 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     amrex::Real qs_minimum_chi_part;
     getWithParser(pp_qed_qs, "chi_min", qs_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarQuantumSyncCtrl ctrl;
+    PicsarQuantumSyncCtrl ctrl;
 
-        //==Table parameters==
+    //==Table parameters==
 
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
 
-        //Minimun chi for the table. If a lepton has chi < tab_dndt_chi_min,
-        //chi is considered as if it were equal to tab_dndt_chi_min
-        getWithParser(pp_qed_qs, "tab_dndt_chi_min", ctrl.dndt_params.chi_part_min);
+    //Minimun chi for the table. If a lepton has chi < tab_dndt_chi_min,
+    //chi is considered as if it were equal to tab_dndt_chi_min
+    getWithParser(pp_qed_qs, "tab_dndt_chi_min", ctrl.dndt_params.chi_part_min);
 
-        //Maximum chi for the table. If a lepton has chi > tab_dndt_chi_max,
-        //chi is considered as if it were equal to tab_dndt_chi_max
-        getWithParser(pp_qed_qs, "tab_dndt_chi_max", ctrl.dndt_params.chi_part_max);
+    //Maximum chi for the table. If a lepton has chi > tab_dndt_chi_max,
+    //chi is considered as if it were equal to tab_dndt_chi_max
+    getWithParser(pp_qed_qs, "tab_dndt_chi_max", ctrl.dndt_params.chi_part_max);
 
-        //How many points should be used for chi in the table
-        pp_qed_qs.get("tab_dndt_how_many", ctrl.dndt_params.chi_part_how_many);
-        //------
+    //How many points should be used for chi in the table
+    pp_qed_qs.get("tab_dndt_how_many", ctrl.dndt_params.chi_part_how_many);
+    //------
 
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //photons.
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //photons.
 
-        //Minimun chi for the table. If a lepton has chi < tab_em_chi_min,
-        //chi is considered as if it were equal to tab_em_chi_min
-        getWithParser(pp_qed_qs, "tab_em_chi_min", ctrl.phot_em_params.chi_part_min);
+    //Minimun chi for the table. If a lepton has chi < tab_em_chi_min,
+    //chi is considered as if it were equal to tab_em_chi_min
+    getWithParser(pp_qed_qs, "tab_em_chi_min", ctrl.phot_em_params.chi_part_min);
 
-        //Maximum chi for the table. If a lepton has chi > tab_em_chi_max,
-        //chi is considered as if it were equal to tab_em_chi_max
-        getWithParser(pp_qed_qs, "tab_em_chi_max", ctrl.phot_em_params.chi_part_max);
+    //Maximum chi for the table. If a lepton has chi > tab_em_chi_max,
+    //chi is considered as if it were equal to tab_em_chi_max
+    getWithParser(pp_qed_qs, "tab_em_chi_max", ctrl.phot_em_params.chi_part_max);
 
-        //How many points should be used for chi in the table
-        pp_qed_qs.get("tab_em_chi_how_many", ctrl.phot_em_params.chi_part_how_many);
+    //How many points should be used for chi in the table
+    pp_qed_qs.get("tab_em_chi_how_many", ctrl.phot_em_params.chi_part_how_many);
 
-        //The other axis of the table is the ratio between the quantum
-        //parameter of the emitted photon and the quantum parameter of the
-        //lepton. This parameter is the minimum ratio to consider for the table.
-        getWithParser(pp_qed_qs, "tab_em_frac_min", ctrl.phot_em_params.frac_min);
+    //The other axis of the table is the ratio between the quantum
+    //parameter of the emitted photon and the quantum parameter of the
+    //lepton. This parameter is the minimum ratio to consider for the table.
+    getWithParser(pp_qed_qs, "tab_em_frac_min", ctrl.phot_em_params.frac_min);
 
-        //This parameter is the number of different points to consider for the second
-        //axis
-        pp_qed_qs.get("tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
-        //====================
+    //This parameter is the number of different points to consider for the second
+    //axis
+    pp_qed_qs.get("tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
+    //====================
 
+    // A table generated with the same parameters is read from the cache
+    std::string cache_name;
+    bool is_cached = false;
+    if(!cache_dir.empty()){
+        cache_name = QedTableCacheFile(cache_dir, "qs", {
+            static_cast<double>(ctrl.dndt_params.chi_part_min),
+            static_cast<double>(ctrl.dndt_params.chi_part_max),
+            static_cast<double>(ctrl.dndt_params.chi_part_how_many),
+            static_cast<double>(ctrl.phot_em_params.chi_part_min),
+            static_cast<double>(ctrl.phot_em_params.chi_part_max),
+            static_cast<double>(ctrl.phot_em_params.chi_part_how_many),
+            static_cast<double>(ctrl.phot_em_params.frac_min),
+            static_cast<double>(ctrl.phot_em_params.frac_how_many)});
+        is_cached = IOProcessorFileExists(cache_name);
+    }
+
+    Vector<char> table_data;
+    if(is_cached){
+        is_cached = ReadQedTableCache(cache_name, table_data);
+        if(is_cached)
+            amrex::Print() << "Quantum Synchrotron table read from cache " << cache_name << "\n";
+    }
+    if(!is_cached && ParallelDescriptor::IOProcessor()){
         m_shr_p_qs_engine->compute_lookup_tables(ctrl, qs_minimum_chi_part);
         const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
+        table_data = Vector<char>{data.begin(), data.end()};
+        if(!table_name.empty())
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name, table_data);
+        if(!cache_name.empty())
+            WriteQedTableCache(cache_dir, cache_name, table_data);
     }
 
-    ParallelDescriptor::Barrier();
-    Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
+    // A generated table is broadcast from memory, which does not depend on
+    // the success of the writes above
+    if(!is_cached){
+        BcastQedTableData(table_data);
+    }
 
     //No need to initialize from raw data for the processor that
     //has just generated the table
-    if(!ParallelDescriptor::IOProcessor()){
+    if(is_cached || !ParallelDescriptor::IOProcessor()){
         m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
             table_data, qs_minimum_chi_part);
     }
+
+    if(is_cached && !table_name.empty() && ParallelDescriptor::IOProcessor()){
+        WarpXUtilIO::WriteBinaryDataOnFile(table_name, table_data);
+    }
 }
 
 void
@@ -1208,8 +1406,10 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     ParmParse pp_qed_bw("qed_bw");
     std::string table_name;
     pp_qed_bw.query("save_table_in", table_name);
-    if(table_name.empty())
-        amrex::Abort("qed_bw.save_table_in should be provided!");
+    std::string cache_dir;
+    pp_qed_bw.query("table_cache_dir", cache_dir);
+    if(table_name.empty() && cache_dir.empty())
+        amrex::Abort("qed_bw.save_table_in or qed_bw.table_cache_dir should be provided!");
 
     // bw_minimum_chi_phot is the minimum chi parameter to be
     // considered for pair production. If a photon has chi < chi_min,
@@ -1217,66 +1417,95 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     amrex::Real bw_minimum_chi_part;
     getWithParser(pp_qed_bw, "chi_min", bw_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarBreitWheelerCtrl ctrl;
+    PicsarBreitWheelerCtrl ctrl;
 
-        //==Table parameters==
+    //==Table parameters==
 
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
 
-        //Minimun chi for the table. If a photon has chi < tab_dndt_chi_min,
-        //an analytical approximation is used.
-        getWithParser(pp_qed_bw, "tab_dndt_chi_min", ctrl.dndt_params.chi_phot_min);
+    //Minimun chi for the table. If a photon has chi < tab_dndt_chi_min,
+    //an analytical approximation is used.
+    getWithParser(pp_qed_bw, "tab_dndt_chi_min", ctrl.dndt_params.chi_phot_min);
 
-        //Maximum chi for the table. If a photon has chi > tab_dndt_chi_max,
-        //an analytical approximation is used.
-        getWithParser(pp_qed_bw, "tab_dndt_chi_max", ctrl.dndt_params.chi_phot_max);
+    //Maximum chi for the table. If a photon has chi > tab_dndt_chi_max,
+    //an analytical approximation is used.
+    getWithParser(pp_qed_bw, "tab_dndt_chi_max", ctrl.dndt_params.chi_phot_max);
 
-        //How many points should be used for chi in the table
-        pp_qed_bw.get("tab_dndt_how_many", ctrl.dndt_params.chi_phot_how_many);
-        //------
+    //How many points should be used for chi in the table
+    pp_qed_bw.get("tab_dndt_how_many", ctrl.dndt_params.chi_phot_how_many);
+    //------
 
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //particles.
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //particles.
 
-        //Minimun chi for the table. If a photon has chi < tab_pair_chi_min
-        //chi is considered as it were equal to chi_phot_tpair_min
-        getWithParser(pp_qed_bw, "tab_pair_chi_min", ctrl.pair_prod_params.chi_phot_min);
+    //Minimun chi for the table. If a photon has chi < tab_pair_chi_min
+    //chi is considered as it were equal to chi_phot_tpair_min
+    getWithParser(pp_qed_bw, "tab_pair_chi_min", ctrl.pair_prod_params.chi_phot_min);
 
-        //Maximum chi for the table. If a photon has chi > tab_pair_chi_max
-        //chi is considered as it were equal to chi_phot_tpair_max
-        getWithParser(pp_qed_bw, "tab_pair_chi_max", ctrl.pair_prod_params.chi_phot_max);
+    //Maximum chi for the table. If a photon has chi > tab_pair_chi_max
+    //chi is considered as it were equal to chi_phot_tpair_max
+    getWithParser(pp_qed_bw, "tab_pair_chi_max", ctrl.pair_prod_params.chi_phot_max);
 
-        //How many points should be used for chi in the table
-        pp_qed_bw.get("tab_pair_chi_how_many", ctrl.pair_prod_params.chi_phot_how_many);
+    //How many points should be used for chi in the table
+    pp_qed_bw.get("tab_pair_chi_how_many", ctrl.pair_prod_params.chi_phot_how_many);
 
-        //The other axis of the table is the fraction of the initial energy
-        //'taken away' by the most energetic particle of the pair.
-        //This parameter is the number of different fractions to consider
-        pp_qed_bw.get("tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
-        //====================
+    //The other axis of the table is the fraction of the initial energy
+    //'taken away' by the most energetic particle of the pair.
+    //This parameter is the number of different fractions to consider
+    pp_qed_bw.get("tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
+    //====================
 
+    // A table generated with the same parameters is read from the cache
+    std::string cache_name;
+    bool is_cached = false;
+    if(!cache_dir.empty()){
+        cache_name = QedTableCacheFile(cache_dir, "bw", {
+            static_cast<double>(ctrl.dndt_params.chi_phot_min),
+            static_cast<double>(ctrl.dndt_params.chi_phot_max),
+            static_cast<double>(ctrl.dndt_params.chi_phot_how_many),
+            static_cast<double>(ctrl.pair_prod_params.chi_phot_min),
+            static_cast<double>(ctrl.pair_prod_params.chi_phot_max),
+            static_cast<double>(ctrl.pair_prod_params.chi_phot_how_many),
+            static_cast<double>(ctrl.pair_prod_params.frac_how_many)});
+        is_cached = IOProcessorFileExists(cache_name);
+    }
+
+    Vector<char> table_data;
+    if(is_cached){
+        is_cached = ReadQedTableCache(cache_name, table_data);
+        if(is_cached)
+            amrex::Print() << "Breit Wheeler table read from cache " << cache_name << "\n";
+    }
+    if(!is_cached && ParallelDescriptor::IOProcessor()){
         m_shr_p_bw_engine->compute_lookup_tables(ctrl, bw_minimum_chi_part);
         const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
+        table_data = Vector<char>{data.begin(), data.end()};
+        if(!table_name.empty())
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name, table_data);
+        if(!cache_name.empty())
+            WriteQedTableCache(cache_dir, cache_name, table_data);
     }
 
-    ParallelDescriptor::Barrier();
-    Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
+    // A generated table is broadcast from memory, which does not depend on
+    // the success of the writes above
+    if(!is_cached){
+        BcastQedTableData(table_data);
+    }
 
     //No need to initialize from raw data for the processor that
     //has just generated the table
-    if(!ParallelDescriptor::IOProcessor()){
+    if(is_cached || !ParallelDescriptor::IOProcessor()){
         m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
             table_data, bw_minimum_chi_part);
     }
+
+    if(is_cached && !table_name.empty() && ParallelDescriptor::IOProcessor()){
+        WarpXUtilIO::WriteBinaryDataOnFile(table_name, table_data);
+    }
 }
 
 void
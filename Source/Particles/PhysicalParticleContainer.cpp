@@ -49,6 +49,7 @@
 #include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
 #include <AMReX_Dim3.H>
+#include <AMReX_DistributionMapping.H>
 #include <AMReX_Extension.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
@@ -76,6 +77,7 @@
 #include <AMReX_ParticleTile.H>
 #include <AMReX_Print.H>
 #include <AMReX_Random.H>
+#include <AMReX_RealBox.H>
 #include <AMReX_SPACE.H>
 #include <AMReX_Scan.H>
 #include <AMReX_StructOfArrays.H>
@@ -95,9 +97,11 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <limits>
 #include <map>
+#include <memory>
 #include <random>
 #include <string>
 #include <utility>
@@ -133,6 +137,35 @@ namespace
         return z0;
     }
 
+    // Part of part_realbox covered by the bounding box of the boxes of ba that are
+    // owned by this rank and intersect part_realbox (e.g. only the boxes at the edge
+    // of the moving window for continuous injection). The returned RealBox is not
+    // ok() if there is no such box.
+    RealBox getLocalRealBox (const BoxArray& ba, const DistributionMapping& dm,
+                             int lev, const RealBox& part_realbox)
+    {
+        Box local_box;
+        bool found = false;
+        for (int i = 0; i < static_cast<int>(ba.size()); ++i) {
+            if (dm[i] != ParallelDescriptor::MyProc()) continue;
+            if (!WarpX::getRealBox(ba[i], lev).intersects(part_realbox)) continue;
+            if (found) {
+                local_box.minBox(ba[i]);
+            } else {
+                local_box = ba[i];
+                found = true;
+            }
+        }
+        if (!found) return RealBox();
+
+        RealBox local_realbox = WarpX::getRealBox(local_box, lev);
+        for (int dir=0; dir<AMREX_SPACEDIM; dir++) {
+            local_realbox.setLo(dir, std::max(local_realbox.lo(dir), part_realbox.lo(dir)));
+            local_realbox.setHi(dir, std::min(local_realbox.hi(dir), part_realbox.hi(dir)));
+        }
+        return local_realbox;
+    }
+
     AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
     XDim3 getCellCoords (const GpuArray<Real, AMREX_SPACEDIM>& lo_corner,
                          const GpuArray<Real, AMREX_SPACEDIM>& dx,
@@ -434,84 +467,106 @@ PhysicalParticleContainer::AddPlasmaFromFile(ParticleReal q_tot,
     Gpu::HostVector<ParticleReal> particle_uy;
 
 #ifdef WARPX_USE_OPENPMD
-    //TODO: Make changes for read/write in multiple MPI ranks
-    if (ParallelDescriptor::IOProcessor()) {
-        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(plasma_injector,
-                                         "AddPlasmaFromFile: plasma injector not initialized.\n");
-        // take ownership of the series and close it when done
-        auto series = std::move(plasma_injector->m_openpmd_input_series);
-
-        // assumption asserts: see PlasmaInjector
-        openPMD::Iteration it = series->iterations.begin()->second;
-        std::string const ps_name = it.particles.begin()->first;
-        openPMD::ParticleSpecies ps = it.particles.begin()->second;
-
-        auto const npart = ps["position"]["x"].getExtent()[0];
-        std::shared_ptr<ParticleReal> ptr_x = ps["position"]["x"].loadChunk<ParticleReal>();
-        double const position_unit_x = ps["position"]["x"].unitSI();
-        std::shared_ptr<ParticleReal> ptr_z = ps["position"]["z"].loadChunk<ParticleReal>();
-        double const position_unit_z = ps["position"]["z"].unitSI();
-        std::shared_ptr<ParticleReal> ptr_ux = ps["momentum"]["x"].loadChunk<ParticleReal>();
-        double const momentum_unit_x = ps["momentum"]["x"].unitSI();
-        std::shared_ptr<ParticleReal> ptr_uz = ps["momentum"]["z"].loadChunk<ParticleReal>();
-        double const momentum_unit_z = ps["momentum"]["z"].unitSI();
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(plasma_injector,
+                                     "AddPlasmaFromFile: plasma injector not initialized.\n");
+    // take ownership of the series and close it when done
+    auto series = std::move(plasma_injector->m_openpmd_input_series);
+
+    // assumption asserts: see PlasmaInjector
+    openPMD::Iteration it = series->iterations.begin()->second;
+    std::string const ps_name = it.particles.begin()->first;
+    openPMD::ParticleSpecies ps = it.particles.begin()->second;
+
+    // Each rank reads a contiguous chunk of the particles, and the particles
+    // are then sent to the rank owning them by a single Redistribute
+    auto const npart = ps["position"]["x"].getExtent()[0];
+    auto const nprocs = static_cast<std::uint64_t>(ParallelDescriptor::NProcs());
+    auto const myproc = static_cast<std::uint64_t>(ParallelDescriptor::MyProc());
+    auto const navg = npart / nprocs;
+    auto const nleft = npart - navg * nprocs;
+    std::uint64_t const offset = myproc * navg + std::min(myproc, nleft);
+    std::uint64_t const nlocal = navg + (myproc < nleft ? 1u : 0u);
+    openPMD::Offset const chunk_offset = {offset};
+    openPMD::Extent const chunk_extent = {nlocal};
+
+    std::shared_ptr<ParticleReal> ptr_x, ptr_y, ptr_z, ptr_ux, ptr_uy, ptr_uz, ptr_w;
+    bool const has_uy = ps["momentum"].contains("y");
+    if (nlocal > 0) {
+        ptr_x = ps["position"]["x"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
+        ptr_z = ps["position"]["z"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
+        ptr_ux = ps["momentum"]["x"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
+        ptr_uz = ps["momentum"]["z"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
 #   ifndef WARPX_DIM_XZ
-        std::shared_ptr<ParticleReal> ptr_y = ps["position"]["y"].loadChunk<ParticleReal>();
-        double const position_unit_y = ps["position"]["y"].unitSI();
+        ptr_y = ps["position"]["y"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
 #   endif
-        std::shared_ptr<ParticleReal> ptr_uy = nullptr;
-        double momentum_unit_y = 1.0;
-        if (ps["momentum"].contains("y")) {
-            ptr_uy = ps["momentum"]["y"].loadChunk<ParticleReal>();
-             momentum_unit_y = ps["momentum"]["y"].unitSI();
-        }
-        series->flush();  // shared_ptr data can be read now
-
-        ParticleReal weight = 1.0_prt;  // base standard: no info means "real" particles
-        if (q_tot != 0.0) {
-            weight = std::abs(q_tot) / ( std::abs(charge) * ParticleReal(npart) );
-            if (ps.contains("weighting")) {
-                Print() << "WARNING: Both '" << ps_name << ".q_tot' and '"
-                        << ps_name << ".injection_file' specify a total charge.\n'"
-                        << ps_name << ".q_tot' will take precedence.\n";
-            }
+        if (has_uy) {
+            ptr_uy = ps["momentum"]["y"].loadChunk<ParticleReal>(chunk_offset, chunk_extent);
         }
-        // ED-PIC extension?
-        else if (ps.contains("weighting")) {
-            // TODO: Add ASSERT_WITH_MESSAGE to test if weighting is a constant record
-            // TODO: Add ASSERT_WITH_MESSAGE for macroWeighted value in ED-PIC
-            ParticleReal w = ps["weighting"][openPMD::RecordComponent::SCALAR].loadChunk<ParticleReal>().get()[0];
-            double const w_unit = ps["weighting"][openPMD::RecordComponent::SCALAR].unitSI();
-            weight = w * w_unit;
+    }
+    double const position_unit_x = ps["position"]["x"].unitSI();
+    double const position_unit_z = ps["position"]["z"].unitSI();
+    double const momentum_unit_x = ps["momentum"]["x"].unitSI();
+    double const momentum_unit_z = ps["momentum"]["z"].unitSI();
+#   ifndef WARPX_DIM_XZ
+    double const position_unit_y = ps["position"]["y"].unitSI();
+#   endif
+    double const momentum_unit_y = has_uy ? ps["momentum"]["y"].unitSI() : 1.0;
+
+    ParticleReal weight = 1.0_prt;  // base standard: no info means "real" particles
+    if (q_tot != 0.0) {
+        weight = std::abs(q_tot) / ( std::abs(charge) * ParticleReal(npart) );
+        if (ps.contains("weighting")) {
+            Print() << "WARNING: Both '" << ps_name << ".q_tot' and '"
+                    << ps_name << ".injection_file' specify a total charge.\n'"
+                    << ps_name << ".q_tot' will take precedence.\n";
         }
+    }
+    // ED-PIC extension?
+    else if (ps.contains("weighting")) {
+        // TODO: Add ASSERT_WITH_MESSAGE to test if weighting is a constant record
+        // TODO: Add ASSERT_WITH_MESSAGE for macroWeighted value in ED-PIC
+        ptr_w = ps["weighting"][openPMD::RecordComponent::SCALAR].loadChunk<ParticleReal>({0u}, {1u});
+    }
+    series->flush();  // shared_ptr data can be read now
 
-        for (auto i = decltype(npart){0}; i<npart; ++i){
-            ParticleReal const x = ptr_x.get()[i]*position_unit_x;
-            ParticleReal const z = ptr_z.get()[i]*position_unit_z+z_shift;
+    if (ptr_w) {
+        double const w_unit = ps["weighting"][openPMD::RecordComponent::SCALAR].unitSI();
+        weight = ptr_w.get()[0] * w_unit;
+    }
+
+    for (auto i = decltype(nlocal){0}; i<nlocal; ++i){
+        ParticleReal const x = ptr_x.get()[i]*position_unit_x;
+        ParticleReal const z = ptr_z.get()[i]*position_unit_z+z_shift;
 #   if (defined WARPX_DIM_3D) || (defined WARPX_DIM_RZ)
-            ParticleReal const y = ptr_y.get()[i]*position_unit_y;
+        ParticleReal const y = ptr_y.get()[i]*position_unit_y;
 #   else
-            ParticleReal const y = 0.0_prt;
+        ParticleReal const y = 0.0_prt;
 #   endif
-            if (plasma_injector->insideBounds(x, y, z)) {
-                ParticleReal const ux = ptr_ux.get()[i]*momentum_unit_x/PhysConst::m_e;
-                ParticleReal const uz = ptr_uz.get()[i]*momentum_unit_z/PhysConst::m_e;
-                ParticleReal uy = 0.0_prt;
-                if (ps["momentum"].contains("y")) {
-                    uy = ptr_uy.get()[i]*momentum_unit_y/PhysConst::m_e;
-                }
-                CheckAndAddParticle(x, y, z, ux, uy, uz, weight,
-                                    particle_x,  particle_y,  particle_z,
-                                    particle_ux, particle_uy, particle_uz,
-                                    particle_w);
+        if (plasma_injector->insideBounds(x, y, z)) {
+            ParticleReal const ux = ptr_ux.get()[i]*momentum_unit_x/PhysConst::m_e;
+            ParticleReal const uz = ptr_uz.get()[i]*momentum_unit_z/PhysConst::m_e;
+            ParticleReal uy = 0.0_prt;
+            if (has_uy) {
+                uy = ptr_uy.get()[i]*momentum_unit_y/PhysConst::m_e;
             }
+            CheckAndAddParticle(x, y, z, ux, uy, uz, weight,
+                                particle_x,  particle_y,  particle_z,
+                                particle_ux, particle_uy, particle_uz,
+                                particle_w);
         }
-        auto const np = particle_z.size();
-        if (np < npart) {
-            Print() << "WARNING: Simulation box doesn't cover all particles\n";
-        }
-    } // IO Processor
+    }
+    // release the file data before adding the particles
+    ptr_x.reset(); ptr_y.reset(); ptr_z.reset();
+    ptr_ux.reset(); ptr_uy.reset(); ptr_uz.reset();
+
     auto const np = particle_z.size();
+    Long np_total = static_cast<Long>(np);
+    ParallelDescriptor::ReduceLongSum(np_total);
+    if (static_cast<std::uint64_t>(np_total) < npart) {
+        Print() << "WARNING: Simulation box doesn't cover all particles\n";
+    }
+
+    // each rank adds its own particles
     AddNParticles(0, np,
                   particle_x.dataPtr(),  particle_y.dataPtr(),  particle_z.dataPtr(),
                   particle_ux.dataPtr(), particle_uy.dataPtr(), particle_uz.dataPtr(),
@@ -672,6 +727,12 @@ PhysicalParticleContainer::AddPlasma (int lev, RealBox part_realbox)
         fine_injection_box.coarsen(rrfac);
     }
 
+    if (plasma_injector->doProfileTable()) {
+        const RealBox local_realbox = getLocalRealBox(ParticleBoxArray(lev),
+            ParticleDistributionMap(lev), lev, part_realbox);
+        if (local_realbox.ok()) plasma_injector->updateProfileTables(local_realbox);
+    }
+
     InjectorPosition* inj_pos = plasma_injector->getInjectorPosition();
     InjectorDensity*  inj_rho = plasma_injector->getInjectorDensity();
     InjectorMomentum* inj_mom = plasma_injector->getInjectorMomentum();
@@ -1072,6 +1133,12 @@ PhysicalParticleContainer::AddPlasmaFlux (int lev, amrex::Real dt)
         fine_injection_box.coarsen(rrfac);
     }
 
+    if (plasma_injector->doProfileTable()) {
+        const RealBox local_realbox = getLocalRealBox(ParticleBoxArray(lev),
+            ParticleDistributionMap(lev), lev, part_realbox);
+        if (local_realbox.ok()) plasma_injector->updateProfileTables(local_realbox);
+    }
+
     InjectorPosition* inj_pos = plasma_injector->getInjectorPosition();
     InjectorDensity*  inj_rho = plasma_injector->getInjectorDensity();
     InjectorMomentum* inj_mom = plasma_injector->getInjectorMomentum();
@@ -2481,6 +2548,99 @@ PhysicalParticleContainer::InitIonizationModule ()
     });
 
     Gpu::synchronize();
+
+    InitIonizationTable();
+}
+
+void
+PhysicalParticleContainer::InitIonizationTable ()
+{
+    ParmParse pp_species_name(species_name);
+    queryWithParser(pp_species_name, "ionization_table_points", adk_table_points);
+
+    // Below the probability w_min per time step, ionization is considered
+    // impossible; above w_max, it is certain (1 - exp(-w_max) = 1)
+    constexpr double log_w_min = -36.8413614879047; // log(1.e-16)
+    constexpr double log_w_max = 3.912023005428146; // log(50.)
+
+    const int nlev = ion_atomic_number;
+    Vector<Real> h_adk_power(nlev), h_adk_prefactor(nlev), h_adk_exp_prefactor(nlev);
+    Gpu::copyAsync(Gpu::deviceToHost, adk_power.begin(), adk_power.end(), h_adk_power.begin());
+    Gpu::copyAsync(Gpu::deviceToHost, adk_prefactor.begin(), adk_prefactor.end(),
+                   h_adk_prefactor.begin());
+    Gpu::copyAsync(Gpu::deviceToHost, adk_exp_prefactor.begin(), adk_exp_prefactor.end(),
+                   h_adk_exp_prefactor.begin());
+    Gpu::synchronize();
+
+    const int npoints = (adk_table_points > 1) ? adk_table_points : 0;
+    Vector<Real> h_table(nlev*npoints);
+    Vector<Real> h_field_min(nlev), h_field_max(nlev, 0._rt);
+    Vector<Real> h_log_field_min(nlev, 0._rt), h_inv_dlog_field(nlev, 0._rt);
+
+    for (int i = 0; i < nlev; ++i)
+    {
+        // log of the ionization rate times dt (without the 1/gamma factor),
+        // as a function of the log of the field. It increases up to
+        // E_peak = -adk_exp_prefactor/(2*n_eff - 1) and decreases beyond.
+        const double log_prefactor = std::log(static_cast<double>(h_adk_prefactor[i]));
+        const double power = h_adk_power[i];
+        const double exp_prefactor = h_adk_exp_prefactor[i];
+        const auto log_w = [=] (double log_E) {
+            return log_prefactor + power*log_E + exp_prefactor*std::exp(-log_E);
+        };
+        if (power >= 0. || !(h_adk_prefactor[i] > 0._rt)) {
+            // no threshold: always use the direct formula
+            h_field_min[i] = 0._rt;
+            continue;
+        }
+        const double log_E_peak = std::log(-exp_prefactor/(-power));
+        if (log_w(log_E_peak) <= log_w_min) {
+            // the probability is negligible for any field
+            h_field_min[i] = std::numeric_limits<Real>::max();
+            continue;
+        }
+
+        // field at which log_w reaches the target, by bisection in [a, log_E_peak]
+        const auto solve = [=] (double a, double target) {
+            double b = log_E_peak;
+            for (int k = 0; k < 200; ++k) {
+                const double m = 0.5*(a + b);
+                if (log_w(m) < target) a = m; else b = m;
+            }
+            return a;
+        };
+        double log_E_lo = log_E_peak - 1.;
+        while (log_w(log_E_lo) > log_w_min) log_E_lo -= 1.;
+        const double log_E_min = solve(log_E_lo, log_w_min);
+        const double log_E_max = (log_w(log_E_peak) > log_w_max) ?
+            solve(log_E_min, log_w_max) : log_E_peak;
+
+        h_field_min[i] = static_cast<Real>(std::exp(log_E_min));
+        if (npoints == 0) continue;
+
+        const double dlog_E = (log_E_max - log_E_min)/(npoints - 1);
+        h_field_max[i] = static_cast<Real>(std::exp(log_E_max));
+        h_log_field_min[i] = static_cast<Real>(log_E_min);
+        h_inv_dlog_field[i] = static_cast<Real>(1./dlog_E);
+        for (int j = 0; j < npoints; ++j) {
+            h_table[i*npoints + j] = static_cast<Real>(log_w(log_E_min + j*dlog_E));
+        }
+    }
+    adk_table_points = npoints;
+
+    adk_table.resize(h_table.size());
+    adk_field_min.resize(nlev);
+    adk_field_max.resize(nlev);
+    adk_log_field_min.resize(nlev);
+    adk_inv_dlog_field.resize(nlev);
+    Gpu::copyAsync(Gpu::hostToDevice, h_table.begin(), h_table.end(), adk_table.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, h_field_min.begin(), h_field_min.end(), adk_field_min.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, h_field_max.begin(), h_field_max.end(), adk_field_max.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, h_log_field_min.begin(), h_log_field_min.end(),
+                   adk_log_field_min.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, h_inv_dlog_field.begin(), h_inv_dlog_field.end(),
+                   adk_inv_dlog_field.begin());
+    Gpu::synchronize();
 }
 
 IonizationFilterFunc
@@ -2502,6 +2662,12 @@ PhysicalParticleContainer::getIonizationFunc (const WarpXParIter& pti,
                                 adk_prefactor.dataPtr(),
                                 adk_exp_prefactor.dataPtr(),
                                 adk_power.dataPtr(),
+                                adk_table.dataPtr(),
+                                adk_field_min.dataPtr(),
+                                adk_field_max.dataPtr(),
+                                adk_log_field_min.dataPtr(),
+                                adk_inv_dlog_field.dataPtr(),
+                                adk_table_points,
                                 particle_icomps["ionization_level"],
                                 ion_atomic_number);
 }
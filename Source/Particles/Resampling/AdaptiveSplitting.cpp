@@ -0,0 +1,191 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "AdaptiveSplitting.H"
+
+#include "Particles/ParticleCreation/SmartUtils.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/ParticleUtils.H"
+#include "Utils/WarpXUtil.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Algorithm.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_DenseBins.H>
+#include <AMReX_Extension.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_PODVector.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Particle.H>
+#include <AMReX_ParticleTile.H>
+#include <AMReX_Particles.H>
+#include <AMReX_RealVect.H>
+#include <AMReX_Scan.H>
+#include <AMReX_StructOfArrays.H>
+
+#include <AMReX_BaseFwd.H>
+
+#include <cmath>
+
+AdaptiveSplitting::AdaptiveSplitting (const std::string species_name)
+{
+    using namespace amrex::literals;
+
+    amrex::ParmParse pp_species_name(species_name);
+    queryWithParser(pp_species_name, "resampling_algorithm_target_ppc", m_target_ppc);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_target_ppc >= 2,
+                                     "Resampling target_ppc should be greater than or equal to 2");
+
+    std::string split_pattern = "diagonal";
+    pp_species_name.query("resampling_algorithm_split_pattern", split_pattern);
+    if (split_pattern == "diagonal") {
+        m_split_type = 0;
+    } else if (split_pattern == "axis") {
+        m_split_type = 1;
+    } else {
+        amrex::Abort("Resampling split_pattern should be either diagonal or axis");
+    }
+
+    queryWithParser(pp_species_name, "resampling_algorithm_split_offset", m_split_offset);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_split_offset > 0._rt && m_split_offset < 0.5_rt,
+                                     "Resampling split_offset should be between 0 and 0.5");
+}
+
+void AdaptiveSplitting::operator() (WarpXParIter& pti, const int lev,
+                                    WarpXParticleContainer * const pc) const
+{
+    using namespace amrex::literals;
+
+    auto& ptile = pc->ParticlesAt(lev, pti);
+    const int np = ptile.numParticles();
+    if (np == 0) return;
+
+    auto bins = ParticleUtils::findParticlesInEachCell(lev, pti, ptile);
+
+    const int n_cells = bins.numBins();
+    const auto indices = bins.permutationPtr();
+    const auto cell_offsets = bins.offsetsPtr();
+
+    const int target_ppc = m_target_ppc;
+    const int split_type = m_split_type;
+    const int np_split = (split_type == 0) ? (1 << AMREX_SPACEDIM) : 2*AMREX_SPACEDIM;
+
+    // First loop over cells: number of particles to split in each cell,
+    // which are moved to the beginning of the cell by decreasing weight
+    const amrex::ParticleReal * const AMREX_RESTRICT w =
+        ptile.GetStructOfArrays().GetRealData(PIdx::w).data();
+    amrex::Gpu::DeviceVector<int> n_split_in_cell(n_cells);
+    amrex::Gpu::DeviceVector<int> new_offsets(n_cells);
+    int * const AMREX_RESTRICT p_n_split_in_cell = n_split_in_cell.data();
+    int * const AMREX_RESTRICT p_new_offsets = new_offsets.data();
+    amrex::ParallelFor( n_cells,
+        [=] AMREX_GPU_DEVICE (int i_cell) noexcept
+        {
+            const auto cell_start = static_cast<int>(cell_offsets[i_cell]);
+            const auto cell_stop  = static_cast<int>(cell_offsets[i_cell+1]);
+            const int cell_numparts = cell_stop - cell_start;
+
+            int n_split = 0;
+            // do nothing for empty cells, or cells that already have enough particles
+            if (cell_numparts > 0 && cell_numparts < target_ppc) {
+                // each split particle adds np_split - 1 particles
+                n_split = amrex::min(cell_numparts,
+                                     (target_ppc - cell_numparts + np_split - 2)/(np_split - 1));
+                // select the heaviest particles (there are fewer than target_ppc particles)
+                for (int i = cell_start; i < cell_start + n_split; ++i) {
+                    int i_max = i;
+                    for (int j = i + 1; j < cell_stop; ++j) {
+                        if (w[indices[j]] > w[indices[i_max]]) i_max = j;
+                    }
+                    amrex::Swap(indices[i], indices[i_max]);
+                }
+            }
+            p_n_split_in_cell[i_cell] = n_split*(np_split - 1);
+        }
+    );
+
+    const int num_added = amrex::Scan::ExclusiveSum(n_cells, p_n_split_in_cell, p_new_offsets);
+    if (num_added == 0) return;
+
+    ptile.resize(np + num_added);
+    const auto ptd = ptile.getParticleTileData();
+
+    const amrex::Geometry& geom = WarpX::GetInstance().Geom(lev);
+    const auto dx = geom.CellSizeArray();
+    const auto dxi = geom.InvCellSizeArray();
+    const auto plo = geom.ProbLoArray();
+    amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> offset;
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) offset[d] = m_split_offset*dx[d];
+
+    // Second loop over cells: split the selected particles. The first split particle
+    // replaces the original particle, the others are appended to the tile.
+    amrex::ParallelFor( n_cells,
+        [=] AMREX_GPU_DEVICE (int i_cell) noexcept
+        {
+            const int n_split = p_n_split_in_cell[i_cell]/(np_split - 1);
+            if (n_split == 0) return;
+
+            const auto cell_start = static_cast<int>(cell_offsets[i_cell]);
+            int i_new = np + p_new_offsets[i_cell];
+            for (int i = cell_start; i < cell_start + n_split; ++i)
+            {
+                const auto ip = indices[i];
+                ptd.m_rdata[PIdx::w][ip] /= np_split;
+
+                // The split particles are displaced symmetrically about the original
+                // particle, by at most its distance to the faces of its cell, so that
+                // they stay in the same cell (and thus in the same tile and in the
+                // domain) and the center of charge is conserved. In RZ, this also
+                // keeps the radius positive for particles close to the axis.
+                amrex::RealVect pos0;
+                amrex::RealVect h;
+                for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                    pos0[d] = ptd.m_aos[ip].pos(d);
+                    const amrex::Real cell_lo = plo[d] + dx[d]*std::floor((pos0[d] - plo[d])*dxi[d]);
+                    h[d] = amrex::min(offset[d],
+                                      0.999_rt*(pos0[d] - cell_lo),
+                                      0.999_rt*(cell_lo + dx[d] - pos0[d]));
+                    h[d] = amrex::max(h[d], 0._rt);
+                }
+
+                for (int k = 0; k < np_split; ++k)
+                {
+                    int dst = ip;
+                    if (k > 0) {
+                        dst = i_new++;
+                        ptd.m_aos[dst] = ptd.m_aos[ip];
+                        for (int j = 0; j < PIdx::nattribs; ++j)
+                            ptd.m_rdata[j][dst] = ptd.m_rdata[j][ip];
+                        for (int j = 0; j < ptd.m_num_runtime_real; ++j)
+                            ptd.m_runtime_rdata[j][dst] = ptd.m_runtime_rdata[j][ip];
+                        for (int j = 0; j < ptd.m_num_runtime_int; ++j)
+                            ptd.m_runtime_idata[j][dst] = ptd.m_runtime_idata[j][ip];
+                    }
+
+                    // Displacement of the split particle k: along each diagonal, the
+                    // sign along direction d is given by the bit d of k. Along each
+                    // axis, particles 2*d and 2*d+1 are displaced along direction d.
+                    for (int d = 0; d < AMREX_SPACEDIM; ++d)
+                    {
+                        amrex::Real shift;
+                        if (split_type == 0) {
+                            shift = ((k >> d) & 1) ? h[d] : -h[d];
+                        } else {
+                            shift = (k/2 != d) ? 0._rt : ((k % 2) ? h[d] : -h[d]);
+                        }
+                        ptd.m_aos[dst].pos(d) = pos0[d] + shift;
+                    }
+                }
+            }
+        }
+    );
+
+    setNewParticleIDs(ptile, np, num_added);
+}
@@ -6,7 +6,9 @@
  */
 #include "Resampling.H"
 
+#include "AdaptiveSplitting.H"
 #include "LevelingThinning.H"
+#include "VelocityMerging.H"
 
 #include <AMReX.H>
 #include <AMReX_ParmParse.H>
@@ -21,6 +23,14 @@ Resampling::Resampling (const std::string species_name)
     {
         m_resampling_algorithm = std::make_unique<LevelingThinning>(species_name);
     }
+    else if (resampling_algorithm_string.compare("velocity_merging") == 0)
+    {
+        m_resampling_algorithm = std::make_unique<VelocityMerging>(species_name);
+    }
+    else if (resampling_algorithm_string.compare("adaptive_splitting") == 0)
+    {
+        m_resampling_algorithm = std::make_unique<AdaptiveSplitting>(species_name);
+    }
     else
     { amrex::Abort("Unknown resampling algorithm."); }
 
@@ -0,0 +1,277 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "VelocityMerging.H"
+
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/ParticleUtils.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXUtil.H"
+
+#include <AMReX.H>
+#include <AMReX_Algorithm.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_DenseBins.H>
+#include <AMReX_Extension.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_PODVector.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Particle.H>
+#include <AMReX_ParticleTile.H>
+#include <AMReX_Particles.H>
+#include <AMReX_Random.H>
+#include <AMReX_StructOfArrays.H>
+
+#include <AMReX_BaseFwd.H>
+
+#include <cmath>
+
+namespace
+{
+    /** Index of the cartesian momentum bin of a particle, within the bounding box
+     *  of the momenta of the particles of its cell */
+    struct MomentumBinKey
+    {
+        const amrex::ParticleReal* AMREX_RESTRICT ux;
+        const amrex::ParticleReal* AMREX_RESTRICT uy;
+        const amrex::ParticleReal* AMREX_RESTRICT uz;
+        amrex::Real lo[3];
+        amrex::Real inv_du[3];
+        int n_bins;
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        int bin (amrex::Real u, int d) const noexcept
+        {
+            return amrex::min(static_cast<int>((u - lo[d])*inv_du[d]), n_bins - 1);
+        }
+
+        template <typename T>
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        int operator() (T ip) const noexcept
+        {
+            return bin(ux[ip], 0) + n_bins*(bin(uy[ip], 1) + n_bins*bin(uz[ip], 2));
+        }
+    };
+
+    /** Sift down step of HeapSort */
+    template <typename T, typename Key>
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void SiftDown (T* a, int root, int n, Key const& key) noexcept
+    {
+        while (true) {
+            int child = 2*root + 1;
+            if (child >= n) return;
+            if (child + 1 < n && key(a[child]) < key(a[child+1])) ++child;
+            if (!(key(a[root]) < key(a[child]))) return;
+            amrex::Swap(a[root], a[child]);
+            root = child;
+        }
+    }
+
+    /** In-place sort of a[0:n] by increasing key, in O(n log n) and without
+     *  additional memory, so that it can be done by a single GPU thread */
+    template <typename T, typename Key>
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void HeapSort (T* a, int n, Key const& key) noexcept
+    {
+        for (int start = n/2 - 1; start >= 0; --start) {
+            SiftDown(a, start, n, key);
+        }
+        for (int end = n - 1; end > 0; --end) {
+            amrex::Swap(a[0], a[end]);
+            SiftDown(a, 0, end, key);
+        }
+    }
+}
+
+VelocityMerging::VelocityMerging (const std::string species_name)
+{
+    amrex::ParmParse pp_species_name(species_name);
+    queryWithParser(pp_species_name, "resampling_algorithm_momentum_bins", m_momentum_bins);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_momentum_bins >= 1,
+                                     "Resampling momentum_bins should be greater than or equal to 1");
+
+    pp_species_name.query("resampling_algorithm_min_ppc", m_min_ppc);
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(m_min_ppc >= 1,
+                                     "Resampling min_ppc should be greater than or equal to 1");
+}
+
+void VelocityMerging::operator() (WarpXParIter& pti, const int lev,
+                                  WarpXParticleContainer * const pc) const
+{
+    using namespace amrex::literals;
+
+    // So that CUDA code gets its intrinsic, not the host-only C++ library version
+    using std::sqrt;
+    using std::cos;
+    using std::sin;
+
+    auto& ptile = pc->ParticlesAt(lev, pti);
+    auto& soa = ptile.GetStructOfArrays();
+    amrex::ParticleReal * const AMREX_RESTRICT w = soa.GetRealData(PIdx::w).data();
+    amrex::ParticleReal * const AMREX_RESTRICT ux = soa.GetRealData(PIdx::ux).data();
+    amrex::ParticleReal * const AMREX_RESTRICT uy = soa.GetRealData(PIdx::uy).data();
+    amrex::ParticleReal * const AMREX_RESTRICT uz = soa.GetRealData(PIdx::uz).data();
+    WarpXParticleContainer::ParticleType * const AMREX_RESTRICT
+                                 particle_ptr = ptile.GetArrayOfStructs()().data();
+
+    auto bins = ParticleUtils::findParticlesInEachCell(lev, pti, ptile);
+
+    const int n_cells = bins.numBins();
+    const auto indices = bins.permutationPtr();
+    const auto cell_offsets = bins.offsetsPtr();
+
+    const int momentum_bins = m_momentum_bins;
+    const int min_ppc = m_min_ppc;
+
+    // Photons have zero mass: their energy is |u|*m_e*c instead of (gamma-1)*m*c^2
+    const bool is_photon = pc->AmIA<PhysicalSpecies::photon>();
+
+    constexpr amrex::Real c = PhysConst::c;
+    constexpr amrex::Real inv_c2 = 1._rt/(PhysConst::c*PhysConst::c);
+
+    // Loop over cells
+    amrex::ParallelForRNG( n_cells,
+        [=] AMREX_GPU_DEVICE (int i_cell, amrex::RandomEngine const& engine) noexcept
+        {
+            // The particles that are in the cell `i_cell` are
+            // given by the `indices[cell_start:cell_stop]`
+            const auto cell_start = static_cast<int>(cell_offsets[i_cell]);
+            const auto cell_stop  = static_cast<int>(cell_offsets[i_cell+1]);
+            const int cell_numparts = cell_stop - cell_start;
+
+            // do nothing for cells with less particles than min_ppc,
+            // or too few particles to be merged
+            if (cell_numparts < min_ppc || cell_numparts < 3)
+                return;
+
+            // Bounding box of the momenta of the cell particles
+            MomentumBinKey key;
+            key.ux = ux;
+            key.uy = uy;
+            key.uz = uz;
+            key.n_bins = momentum_bins;
+            amrex::Real hi[3];
+            {
+                const auto ip = indices[cell_start];
+                key.lo[0] = hi[0] = ux[ip];
+                key.lo[1] = hi[1] = uy[ip];
+                key.lo[2] = hi[2] = uz[ip];
+            }
+            for (int i = cell_start + 1; i < cell_stop; ++i)
+            {
+                const auto ip = indices[i];
+                const amrex::Real u[3] = {ux[ip], uy[ip], uz[ip]};
+                for (int d = 0; d < 3; ++d) {
+                    key.lo[d] = amrex::min(key.lo[d], u[d]);
+                    hi[d] = amrex::max(hi[d], u[d]);
+                }
+            }
+            for (int d = 0; d < 3; ++d) {
+                key.inv_du[d] = (hi[d] > key.lo[d]) ? momentum_bins/(hi[d] - key.lo[d]) : 0._rt;
+            }
+
+            // Sort the cell particles by momentum bin, so that the particles of
+            // each bin are contiguous
+            HeapSort(indices + cell_start, cell_numparts, key);
+
+            // Loop over the momentum bins of the cell
+            int bin_start = cell_start;
+            while (bin_start < cell_stop)
+            {
+                const int bin_key = key(indices[bin_start]);
+                int bin_stop = bin_start + 1;
+                while (bin_stop < cell_stop && key(indices[bin_stop]) == bin_key) ++bin_stop;
+
+                if (bin_stop - bin_start < 3) {
+                    bin_start = bin_stop;
+                    continue;
+                }
+
+                // Total weight, momentum and energy (in units of m*c^2) of the bin
+                amrex::Real w_t = 0._rt, px = 0._rt, py = 0._rt, pz = 0._rt, e_t = 0._rt;
+                for (int i = bin_start; i < bin_stop; ++i)
+                {
+                    const auto ip = indices[i];
+                    const amrex::Real wi = w[ip];
+                    const amrex::Real u2 = (ux[ip]*ux[ip] + uy[ip]*uy[ip] + uz[ip]*uz[ip])*inv_c2;
+                    w_t += wi;
+                    px += wi*ux[ip];
+                    py += wi*uy[ip];
+                    pz += wi*uz[ip];
+                    // gamma - 1, written without cancellation for non-relativistic particles
+                    e_t += wi*(is_photon ? sqrt(u2) : u2/(sqrt(1._rt + u2) + 1._rt));
+                }
+                if (w_t <= 0._rt) {
+                    bin_start = bin_stop;
+                    continue;
+                }
+
+                // Both new particles have the average energy, and therefore the
+                // momentum norm u_a. Their momenta make an angle omega with the
+                // total momentum, so that their sum is the total momentum.
+                const amrex::Real e_a = e_t/w_t;
+                const amrex::Real u_a = is_photon ? c*e_a : c*sqrt(e_a*(e_a + 2._rt));
+                const amrex::Real p_norm = sqrt(px*px + py*py + pz*pz);
+                const amrex::Real cos_w = (u_a > 0._rt) ?
+                    amrex::min(p_norm/(w_t*u_a), 1._rt) : 1._rt;
+                const amrex::Real sin_w = sqrt(1._rt - cos_w*cos_w);
+
+                // Unit vector along the total momentum
+                amrex::Real e1[3] = {1._rt, 0._rt, 0._rt};
+                if (p_norm > 0._rt) {
+                    e1[0] = px/p_norm;
+                    e1[1] = py/p_norm;
+                    e1[2] = pz/p_norm;
+                }
+                // Unit vectors perpendicular to e1, from the axis least aligned with e1
+                int d_min = 0;
+                for (int d = 1; d < 3; ++d) {
+                    if (std::abs(e1[d]) < std::abs(e1[d_min])) d_min = d;
+                }
+                amrex::Real axis[3] = {0._rt, 0._rt, 0._rt};
+                axis[d_min] = 1._rt;
+                amrex::Real e2[3] = {axis[1]*e1[2] - axis[2]*e1[1],
+                                     axis[2]*e1[0] - axis[0]*e1[2],
+                                     axis[0]*e1[1] - axis[1]*e1[0]};
+                const amrex::Real e2_norm = sqrt(e2[0]*e2[0] + e2[1]*e2[1] + e2[2]*e2[2]);
+                for (int d = 0; d < 3; ++d) e2[d] /= e2_norm;
+                const amrex::Real e3[3] = {e1[1]*e2[2] - e1[2]*e2[1],
+                                           e1[2]*e2[0] - e1[0]*e2[2],
+                                           e1[0]*e2[1] - e1[1]*e2[0]};
+
+                // The plane of the two momenta is randomly rotated around e1
+                const amrex::Real phi = 2._rt*MathConst::pi*amrex::Random(engine);
+                const amrex::Real cos_phi = cos(phi);
+                const amrex::Real sin_phi = sin(phi);
+                amrex::Real u_par[3], u_perp[3];
+                for (int d = 0; d < 3; ++d) {
+                    u_par[d] = u_a*cos_w*e1[d];
+                    u_perp[d] = u_a*sin_w*(cos_phi*e2[d] + sin_phi*e3[d]);
+                }
+
+                // The first two particles of the bin are kept, the others are removed
+                const auto ia = indices[bin_start];
+                const auto ib = indices[bin_start + 1];
+                w[ia] = 0.5_rt*w_t;
+                w[ib] = 0.5_rt*w_t;
+                ux[ia] = u_par[0] + u_perp[0];
+                uy[ia] = u_par[1] + u_perp[1];
+                uz[ia] = u_par[2] + u_perp[2];
+                ux[ib] = u_par[0] - u_perp[0];
+                uy[ib] = u_par[1] - u_perp[1];
+                uz[ib] = u_par[2] - u_perp[2];
+                for (int i = bin_start + 2; i < bin_stop; ++i)
+                {
+                    particle_ptr[indices[i]].id() = -1;
+                }
+
+                bin_start = bin_stop;
+            }
+        }
+    );
+}
@@ -1056,6 +1056,40 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
     }
 }
 
+amrex::Long WarpXParticleContainer::ParticleDataBytes () const
+{
+    amrex::Long bytes = 0;
+    const int nreal = NumRealComps();
+    const int nint = NumIntComps();
+    for (const auto& plev : GetParticles()) {
+        for (const auto& kv : plev) {
+            const auto& ptile = kv.second;
+            bytes += ptile.GetArrayOfStructs()().capacity()*sizeof(ParticleType);
+            const auto& soa = ptile.GetStructOfArrays();
+            for (int i = 0; i < nreal; ++i) {
+                bytes += soa.GetRealData(i).capacity()*sizeof(ParticleReal);
+            }
+            for (int i = 0; i < nint; ++i) {
+                bytes += soa.GetIntData(i).capacity()*sizeof(int);
+            }
+        }
+    }
+    return bytes;
+}
+
+amrex::Long WarpXParticleContainer::TmpParticleDataBytes () const
+{
+    amrex::Long bytes = 0;
+    for (const auto& tmp_lev : tmp_particle_data) {
+        for (const auto& kv : tmp_lev) {
+            for (const auto& attrib : kv.second) {
+                bytes += attrib.capacity()*sizeof(ParticleReal);
+            }
+        }
+    }
+    return bytes;
+}
+
 // When using runtime components, AMReX requires to touch all tiles
 // in serial and create particles tiles with runtime components if
 // they do not exist (or if they were defined by default, i.e.,
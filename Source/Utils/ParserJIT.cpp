@@ -0,0 +1,453 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ParserJIT.H"
+
+#include "Utils/WarpXUtil.H"
+
+#include <AMReX.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+
+#if defined(WARPX_PARSER_JIT) && !defined(AMREX_USE_GPU)
+#   include <dlfcn.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+#if defined(WARPX_PARSER_JIT) && !defined(AMREX_USE_GPU)
+    /** Translation of the syntax of amrex::Parser to a C++ function body.
+     *  The grammar and the precedence of the operators follow amrex::Parser:
+     *  statements separated by ';', assignments to local variables, the operators
+     *  or, and, == !=, < > <= >=, + -, * /, unary - +, and ^ or ** (right associative),
+     *  and the usual math functions. Anything else makes the translation fail, so
+     *  that the expression is evaluated by the interpreter. */
+    class Translator
+    {
+    public:
+        Translator (std::string const& expr, amrex::Vector<std::string> const& varnames)
+            : m_varnames(varnames.begin(), varnames.end())
+        {
+            Tokenize(expr);
+        }
+
+        /** C++ statements computing the expression, which ends with a return statement,
+         *  or an empty string if the expression is not supported */
+        std::string Body ()
+        {
+            std::ostringstream body;
+            while (m_ok) {
+                std::string name;
+                if (Peek(0).kind == Kind::ident && Peek(1).text == "=") {
+                    name = Next().text;
+                    Next();
+                }
+                const std::string rhs = Expr();
+                if (!m_ok) break;
+                if (!name.empty()) {
+                    if (m_varnames.count(name) || m_locals.count(name)) return Fail();
+                    m_locals.insert(name);
+                    body << "    const double v_" << name << " = " << rhs << ";\n";
+                }
+                if (Peek(0).text == ";") Next();
+                if (Peek(0).kind == Kind::end) {
+                    if (!name.empty()) return Fail();
+                    body << "    return " << rhs << ";\n";
+                    return body.str();
+                }
+                if (name.empty()) return Fail();
+            }
+            return std::string();
+        }
+
+        /** Symbols that are neither variables nor local variables */
+        std::set<std::string> const& Constants () const { return m_constants; }
+
+    private:
+        enum struct Kind { number, ident, op, end };
+        struct Token { Kind kind; std::string text; };
+
+        std::vector<Token> m_tokens;
+        std::size_t m_pos = 0;
+        bool m_ok = true;
+        std::set<std::string> m_varnames;
+        std::set<std::string> m_locals;
+        std::set<std::string> m_constants;
+
+        std::string Fail () { m_ok = false; return std::string(); }
+
+        Token const& Peek (std::size_t i) const
+        {
+            return m_tokens[std::min(m_pos + i, m_tokens.size() - 1)];
+        }
+
+        Token const& Next () { return m_tokens[std::min(m_pos++, m_tokens.size() - 1)]; }
+
+        void Tokenize (std::string const& s)
+        {
+            std::size_t i = 0;
+            while (i < s.size()) {
+                const char c = s[i];
+                if (std::isspace(static_cast<unsigned char>(c))) {
+                    ++i;
+                } else if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+                    const char* begin = s.c_str() + i;
+                    char* end = nullptr;
+                    const double v = std::strtod(begin, &end);
+                    if (end == begin) { m_ok = false; return; }
+                    std::ostringstream os;
+                    os << std::scientific << std::setprecision(17) << v;
+                    m_tokens.push_back({Kind::number, os.str()});
+                    i += static_cast<std::size_t>(end - begin);
+                } else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+                    std::size_t j = i;
+                    while (j < s.size() && (std::isalnum(static_cast<unsigned char>(s[j])) || s[j] == '_')) ++j;
+                    m_tokens.push_back({Kind::ident, s.substr(i, j - i)});
+                    i = j;
+                } else {
+                    static const char* two_chars[] = {"**", "<=", ">=", "==", "!="};
+                    std::string op(1, c);
+                    for (auto const* t : two_chars) {
+                        if (s.compare(i, 2, t) == 0) op = t;
+                    }
+                    if (op.size() == 1 && std::string("+-*/^<>=(),;").find(c) == std::string::npos) {
+                        m_ok = false;
+                        return;
+                    }
+                    m_tokens.push_back({Kind::op, op});
+                    i += op.size();
+                }
+            }
+            m_tokens.push_back({Kind::end, ""});
+        }
+
+        std::string Expr () { return Or(); }
+
+        std::string Or ()
+        {
+            std::string lhs = And();
+            while (m_ok && Peek(0).kind == Kind::ident && Peek(0).text == "or") {
+                Next();
+                lhs = "double((" + lhs + ") != 0. || (" + And() + ") != 0.)";
+            }
+            return lhs;
+        }
+
+        std::string And ()
+        {
+            std::string lhs = Equality();
+            while (m_ok && Peek(0).kind == Kind::ident && Peek(0).text == "and") {
+                Next();
+                lhs = "double((" + lhs + ") != 0. && (" + Equality() + ") != 0.)";
+            }
+            return lhs;
+        }
+
+        std::string Equality ()
+        {
+            std::string lhs = Relational();
+            while (m_ok && (Peek(0).text == "==" || Peek(0).text == "!=")) {
+                const std::string op = Next().text;
+                lhs = "double((" + lhs + ") " + op + " (" + Relational() + "))";
+            }
+            return lhs;
+        }
+
+        std::string Relational ()
+        {
+            std::string lhs = Additive();
+            while (m_ok && Peek(0).kind == Kind::op &&
+                   (Peek(0).text == "<" || Peek(0).text == ">" ||
+                    Peek(0).text == "<=" || Peek(0).text == ">=")) {
+                const std::string op = Next().text;
+                lhs = "double((" + lhs + ") " + op + " (" + Additive() + "))";
+            }
+            return lhs;
+        }
+
+        std::string Additive ()
+        {
+            std::string lhs = Multiplicative();
+            while (m_ok && (Peek(0).text == "+" || Peek(0).text == "-")) {
+                const std::string op = Next().text;
+                lhs = "(" + lhs + " " + op + " " + Multiplicative() + ")";
+            }
+            return lhs;
+        }
+
+        std::string Multiplicative ()
+        {
+            std::string lhs = Unary();
+            while (m_ok && (Peek(0).text == "*" || Peek(0).text == "/")) {
+                const std::string op = Next().text;
+                lhs = "(" + lhs + " " + op + " " + Unary() + ")";
+            }
+            return lhs;
+        }
+
+        std::string Unary ()
+        {
+            if (Peek(0).text == "-") { Next(); return "(-" + Unary() + ")"; }
+            if (Peek(0).text == "+") { Next(); return Unary(); }
+            return Power();
+        }
+
+        std::string Power ()
+        {
+            const std::string base = Primary();
+            if (m_ok && (Peek(0).text == "^" || Peek(0).text == "**")) {
+                Next();
+                // right associative, and binds tighter than a unary minus on its left
+                return "std::pow(" + base + ", " + Unary() + ")";
+            }
+            return base;
+        }
+
+        std::vector<std::string> Arguments ()
+        {
+            std::vector<std::string> args;
+            if (Next().text != "(") { Fail(); return args; }
+            while (m_ok) {
+                args.push_back(Expr());
+                const std::string sep = Next().text;
+                if (sep == ")") break;
+                if (sep != ",") Fail();
+            }
+            return args;
+        }
+
+        std::string Primary ()
+        {
+            if (!m_ok) return std::string();
+            const Token t = Next();
+            if (t.kind == Kind::number) return t.text;
+            if (t.text == "(") {
+                const std::string e = Expr();
+                if (Next().text != ")") return Fail();
+                return "(" + e + ")";
+            }
+            if (t.kind != Kind::ident) return Fail();
+
+            if (Peek(0).text != "(") {
+                if (m_varnames.count(t.text) == 0 && m_locals.count(t.text) == 0) {
+                    m_constants.insert(t.text);
+                }
+                return "v_" + t.text;
+            }
+
+            static const std::map<std::string, std::string> functions1 = {
+                {"sqrt", "std::sqrt"}, {"exp", "std::exp"}, {"log", "std::log"},
+                {"log10", "std::log10"}, {"sin", "std::sin"}, {"cos", "std::cos"},
+                {"tan", "std::tan"}, {"asin", "std::asin"}, {"acos", "std::acos"},
+                {"atan", "std::atan"}, {"sinh", "std::sinh"}, {"cosh", "std::cosh"},
+                {"tanh", "std::tanh"}, {"abs", "std::abs"}, {"fabs", "std::abs"},
+                {"floor", "std::floor"}, {"ceil", "std::ceil"}, {"erf", "std::erf"}};
+            const auto args = Arguments();
+            if (!m_ok) return std::string();
+            const auto f1 = functions1.find(t.text);
+            if (f1 != functions1.end() && args.size() == 1) {
+                return f1->second + "(" + args[0] + ")";
+            } else if (t.text == "pow" && args.size() == 2) {
+                return "std::pow(" + args[0] + ", " + args[1] + ")";
+            } else if (t.text == "atan2" && args.size() == 2) {
+                return "std::atan2(" + args[0] + ", " + args[1] + ")";
+            } else if (t.text == "min" && args.size() == 2) {
+                return "std::fmin(" + args[0] + ", " + args[1] + ")";
+            } else if (t.text == "max" && args.size() == 2) {
+                return "std::fmax(" + args[0] + ", " + args[1] + ")";
+            } else if (t.text == "heaviside" && args.size() == 2) {
+                return "heaviside(" + args[0] + ", " + args[1] + ")";
+            } else if (t.text == "if" && args.size() == 3) {
+                return "((" + args[0] + ") != 0. ? (" + args[1] + ") : (" + args[2] + "))";
+            }
+            return Fail();
+        }
+    };
+
+    /** 64-bit FNV-1a hash, used to name the generated files */
+    std::uint64_t Hash (std::string const& s)
+    {
+        std::uint64_t h = 14695981039346656037ULL;
+        for (const char c : s) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    /** Path quoted for the shell, so that it may contain spaces or special characters */
+    std::string ShellQuote (std::string const& path)
+    {
+        std::string quoted = "'";
+        for (const char c : path) {
+            if (c == '\'') {
+                quoted += "'\\''";
+            } else {
+                quoted += c;
+            }
+        }
+        return quoted + "'";
+    }
+#endif
+
+    std::string Key (std::string const& expr, amrex::Vector<std::string> const& varnames)
+    {
+        std::string key = expr;
+        for (auto const& v : varnames) key += '\0' + v;
+        return key;
+    }
+
+    std::map<std::string, ParserJIT::FunctionType>& Functions ()
+    {
+        static std::map<std::string, ParserJIT::FunctionType> functions;
+        return functions;
+    }
+}
+
+bool
+ParserJIT::enabled ()
+{
+#if defined(WARPX_PARSER_JIT) && !defined(AMREX_USE_GPU)
+    static const bool is_enabled = [] () {
+        int parser_jit = 1;
+        amrex::ParmParse pp_warpx("warpx");
+        pp_warpx.query("parser_jit", parser_jit);
+        return parser_jit != 0;
+    }();
+    return is_enabled;
+#else
+    return false;
+#endif
+}
+
+void
+ParserJIT::compile (std::string const& expr, amrex::Vector<std::string> const& varnames)
+{
+    if (!enabled()) return;
+    const std::string key = Key(expr, varnames);
+    if (Functions().count(key)) return;
+    Functions()[key] = nullptr;
+
+#if defined(WARPX_PARSER_JIT) && !defined(AMREX_USE_GPU)
+    // The translation is deterministic, so that all ranks agree on whether to compile
+    Translator translator(expr, varnames);
+    const std::string body = translator.Body();
+    if (body.empty()) {
+        amrex::Print() << "Parser JIT: expression not supported, using the interpreter: "
+                       << expr << "\n";
+        return;
+    }
+
+    std::ostringstream src;
+    src << "// Generated by WarpX from: " << expr << "\n"
+        << "#include <cmath>\n\n"
+        << "namespace {\n"
+        << "inline double heaviside (double a, double b)\n"
+        << "{ return (a < 0.) ? 0. : ((a > 0.) ? 1. : b); }\n"
+        << "}\n\n";
+    const std::string real_type = (sizeof(amrex::Real) == sizeof(float)) ? "float" : "double";
+    std::ostringstream signature;
+    signature << "extern \"C\" " << real_type << " FUNCTION_NAME (const " << real_type << "* v)";
+    std::string source_head = src.str() + signature.str() + "\n{\n";
+    std::ostringstream vars;
+    for (int i = 0; i < static_cast<int>(varnames.size()); ++i) {
+        vars << "    const double v_" << varnames[i] << " = v[" << i << "];\n";
+    }
+    // Values of the user-defined and physical constants, resolved as makeParser does
+    for (auto const& c : translator.Constants()) {
+        vars << "    const double v_" << c << " = " << std::scientific << std::setprecision(17)
+             << parseStringtoReal(c) << ";\n";
+    }
+    std::string source = source_head + vars.str() + body + "}\n";
+
+    std::ostringstream name;
+    name << "warpx_parser_" << std::hex << Hash(source) << (real_type == "float" ? "_sp" : "_dp");
+    const std::string func_name = name.str();
+    const auto macro_pos = source.find("FUNCTION_NAME");
+    source.replace(macro_pos, std::string("FUNCTION_NAME").size(), func_name);
+
+    std::string jit_dir = "parser_jit";
+    std::string compiler = "c++";
+    std::string flags = "-O3 -fPIC -shared";
+    amrex::ParmParse pp_warpx("warpx");
+    pp_warpx.query("parser_jit_dir", jit_dir);
+    pp_warpx.query("parser_jit_compiler", compiler);
+    pp_warpx.query("parser_jit_flags", flags);
+    const std::string lib = jit_dir + "/" + func_name + ".so";
+
+    // The I/O processor compiles the library, unless it exists from a previous run.
+    // The source and library are written to files with a random suffix, and the
+    // library is renamed when complete, so that concurrent runs sharing jit_dir
+    // neither overwrite each other's files nor load a partially written library.
+    int success = 1;
+    if (amrex::ParallelDescriptor::IOProcessor() && !amrex::FileExists(lib)) {
+        success = 0;
+        if (amrex::UtilCreateDirectory(jit_dir, 0755)) {
+            std::random_device rd;
+            std::ostringstream suffix;
+            suffix << ".tmp" << std::hex << rd() << rd();
+            const std::string cpp = jit_dir + "/" + func_name + suffix.str() + ".cpp";
+            const std::string tmp = lib + suffix.str();
+            std::ofstream ofs(cpp);
+            ofs << source;
+            ofs.close();
+            const std::string command = compiler + " " + flags + " -o " + ShellQuote(tmp)
+                + " " + ShellQuote(cpp);
+            if (ofs.good() && std::system(command.c_str()) == 0) {
+                success = (std::rename(tmp.c_str(), lib.c_str()) == 0);
+            }
+            if (success) {
+                // the source is kept next to the library, for reference
+                std::rename(cpp.c_str(), (jit_dir + "/" + func_name + ".cpp").c_str());
+            } else {
+                std::remove(cpp.c_str());
+                std::remove(tmp.c_str());
+            }
+        }
+    }
+    amrex::ParallelDescriptor::Bcast(&success, 1, amrex::ParallelDescriptor::IOProcessorNumber());
+
+    void* handle = success ? dlopen(lib.c_str(), RTLD_NOW | RTLD_LOCAL) : nullptr;
+    void* func = handle ? dlsym(handle, func_name.c_str()) : nullptr;
+
+    // All the ranks must evaluate the expression the same way, so they all use the
+    // interpreter if the library could not be loaded on one of them
+    int loaded = (func != nullptr);
+    amrex::ParallelDescriptor::ReduceIntMin(loaded);
+    if (!loaded) {
+        if (handle) dlclose(handle);
+        amrex::Warning("Parser JIT: compilation or loading of " + lib
+                       + " failed on at least one rank, using the interpreter for: " + expr);
+        return;
+    }
+    Functions()[key] = reinterpret_cast<FunctionType>(func);
+#endif
+}
+
+ParserJIT::FunctionType
+ParserJIT::getFunction (std::string const& expr, amrex::Vector<std::string> const& varnames)
+{
+    if (!enabled()) return nullptr;
+    const auto it = Functions().find(Key(expr, varnames));
+    return (it == Functions().end()) ? nullptr : it->second;
+}
@@ -0,0 +1,96 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "StepTimers.H"
+
+#include <AMReX_BLassert.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_Utility.H>
+
+#ifdef AMREX_USE_OMP
+#   include <omp.h>
+#endif
+
+bool StepTimers::m_enabled = false;
+bool StepTimers::m_synchronize = false;
+int StepTimers::m_epoch = 0;
+double StepTimers::m_start_time = 0.;
+double StepTimers::m_last_time = 0.;
+std::array<double, StepTimers::NumPhases> StepTimers::m_times = {};
+std::vector<int> StepTimers::m_stack;
+
+StepTimers::Scope::Scope (Phase phase)
+    : m_active(StepTimers::m_enabled &&
+               (StepTimers::m_stack.empty() ||
+                (StepTimers::m_stack.back() != StepTimers::Diagnostics &&
+                 StepTimers::m_stack.back() != StepTimers::LoadBalance)))
+{
+    if (m_active) StepTimers::Enter(phase);
+}
+
+StepTimers::Scope::~Scope ()
+{
+    if (m_active) StepTimers::Leave();
+}
+
+void
+StepTimers::Enable (bool synchronize)
+{
+    m_enabled = true;
+    m_synchronize = m_synchronize || synchronize;
+}
+
+void
+StepTimers::Start ()
+{
+    if (m_synchronize) amrex::Gpu::synchronize();
+    m_start_time = amrex::second();
+    m_last_time = m_start_time;
+    m_times.fill(0.);
+    ++m_epoch;
+}
+
+std::array<double, StepTimers::NumPhases>
+StepTimers::PhaseTimes ()
+{
+    return m_times;
+}
+
+const char*
+StepTimers::Name (int phase)
+{
+    static const char* names[NumPhases] = {"push_deposit", "field_solve", "communication",
+        "diagnostics", "sorting", "redistribute", "collisions", "load_balance"};
+    return names[phase];
+}
+
+void
+StepTimers::Enter (Phase phase)
+{
+#ifdef AMREX_USE_OMP
+    AMREX_ASSERT_WITH_MESSAGE(!omp_in_parallel(),
+        "StepTimers::Scope must not be opened inside an OpenMP parallel region");
+#endif
+    if (m_synchronize) amrex::Gpu::synchronize();
+    const double now = amrex::second();
+    if (!m_stack.empty()) m_times[m_stack.back()] += now - m_last_time;
+    m_stack.push_back(phase);
+    m_last_time = now;
+}
+
+void
+StepTimers::Leave ()
+{
+#ifdef AMREX_USE_OMP
+    AMREX_ASSERT_WITH_MESSAGE(!omp_in_parallel(),
+        "StepTimers::Scope must not be closed inside an OpenMP parallel region");
+#endif
+    if (m_synchronize) amrex::Gpu::synchronize();
+    const double now = amrex::second();
+    m_times[m_stack.back()] += now - m_last_time;
+    m_stack.pop_back();
+    m_last_time = now;
+}
@@ -30,6 +30,7 @@
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "Python/WarpXWrappers.h"
+#include "Utils/MemoryCounter.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXUtil.H"
@@ -484,6 +485,15 @@ WarpX::ReadParameters ()
         pp_warpx.queryarr("override_sync_intervals", override_sync_intervals_string_vec);
         override_sync_intervals = IntervalsParser(override_sync_intervals_string_vec);
 
+        pp_warpx.query("do_autotune", do_autotune);
+        if (do_autotune)
+        {
+            queryWithParser(pp_warpx, "autotune_trial_steps", autotune_trial_steps);
+            pp_warpx.queryarr("autotune_max_grid_size", autotune_max_grid_size);
+            pp_warpx.queryarr("autotune_tile_size", autotune_tile_size);
+            pp_warpx.query("autotune_file", autotune_file);
+        }
+
         AMREX_ALWAYS_ASSERT_WITH_MESSAGE(do_subcycling != 1 || max_level <= 1,
                                          "Subcycling method 1 only works for 2 levels.");
 
@@ -847,6 +857,11 @@ WarpX::ReadParameters ()
         load_balance_intervals = IntervalsParser(load_balance_intervals_string_vec);
         pp_algo.query("load_balance_with_sfc", load_balance_with_sfc);
         pp_algo.query("load_balance_knapsack_factor", load_balance_knapsack_factor);
+        pp_algo.query("load_balance_rechop", load_balance_rechop);
+        queryWithParser(pp_algo, "load_balance_rechop_split_factor", load_balance_rechop_split_factor);
+        queryWithParser(pp_algo, "load_balance_rechop_merge_factor", load_balance_rechop_merge_factor);
+        queryWithParser(pp_algo, "load_balance_rechop_margin", load_balance_rechop_margin);
+        queryWithParser(pp_algo, "load_balance_rechop_cooldown", load_balance_rechop_cooldown);
         queryWithParser(pp_algo, "load_balance_efficiency_ratio_threshold",
                         load_balance_efficiency_ratio_threshold);
         load_balance_costs_update_algo = GetAlgorithmInteger(pp_algo, "load_balance_costs_update");
@@ -2123,6 +2138,84 @@ WarpX::getCosts (int lev)
     }
 }
 
+WarpX::FieldMemoryUsage
+WarpX::ComputeFieldMemoryUsage () const
+{
+    FieldMemoryUsage usage;
+    // The categories are counted in this order, so that an alias
+    // is attributed to the category of the data it refers to
+    MemoryCounter counter;
+
+    counter.add(Efield_fp);
+    counter.add(Bfield_fp);
+    counter.add(current_fp);
+    counter.add(current_store);
+    counter.add(current_fp_nodal);
+    counter.add(rho_fp);
+    counter.add(phi_fp);
+    counter.add(F_fp);
+    counter.add(G_fp);
+    usage.fp = counter.take();
+
+    counter.add(Efield_cp);
+    counter.add(Bfield_cp);
+    counter.add(current_cp);
+    counter.add(rho_cp);
+    counter.add(F_cp);
+    counter.add(G_cp);
+    counter.add(Efield_cax);
+    counter.add(Bfield_cax);
+    counter.add(current_buf);
+    counter.add(charge_buf);
+    counter.add(current_buffer_masks);
+    counter.add(gather_buffer_masks);
+    usage.cp = counter.take();
+
+    counter.add(Efield_avg_fp);
+    counter.add(Bfield_avg_fp);
+    counter.add(Efield_avg_cp);
+    counter.add(Bfield_avg_cp);
+    usage.avg = counter.take();
+
+    counter.add(Efield_aux);
+    counter.add(Bfield_aux);
+    usage.aux = counter.take();
+
+    for (auto const& p : pml) {
+        if (p) p->CountMemory(counter);
+    }
+    usage.pml = counter.take();
+
+#ifdef WARPX_USE_PSATD
+    for (auto const& solver : spectral_solver_fp) {
+        if (solver) solver->CountMemory(counter);
+    }
+    for (auto const& solver : spectral_solver_cp) {
+        if (solver) solver->CountMemory(counter);
+    }
+    usage.spectral = counter.take();
+#endif
+
+    counter.add(m_edge_lengths);
+    counter.add(m_face_areas);
+    counter.add(m_area_mod);
+    counter.add(m_flag_info_face);
+    counter.add(m_flag_ext_face);
+    counter.add(Venl);
+    counter.add(ECTRhofield);
+    counter.add(m_distance_to_eb);
+    usage.eb = counter.take();
+
+    if (multi_diags) multi_diags->CountMemory(counter);
+    if (myBFD) myBFD->CountMemory(counter);
+    counter.add(current_slice);
+    counter.add(Efield_slice);
+    counter.add(Bfield_slice);
+    usage.diagnostics = counter.take();
+
+    return usage;
+}
+
 void
 WarpX::BuildBufferMasks ()
 {
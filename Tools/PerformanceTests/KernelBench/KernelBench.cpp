@@ -0,0 +1,667 @@
+/* Copyright 2021 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
+#include "FieldSolver/FiniteDifferenceSolver/FiniteDifferenceSolver.H"
+#ifdef WARPX_USE_PSATD
+#   include "FieldSolver/SpectralSolver/SpectralSolver.H"
+#endif
+#include "Filter/BilinearFilter.H"
+#include "Initialization/WarpXAMReXInit.H"
+#include "Particles/Deposition/ChargeDeposition.H"
+#include "Particles/Deposition/CurrentDeposition.H"
+#include "Particles/Gather/FieldGather.H"
+#include "Particles/Gather/GetExternalFields.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
+#include "Particles/Pusher/UpdateMomentumBoris.H"
+#include "Particles/Pusher/UpdateMomentumBorisWithRadiationReaction.H"
+#include "Particles/Pusher/UpdateMomentumHigueraCary.H"
+#include "Particles/Pusher/UpdateMomentumVay.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/MPIInitHelpers.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Array.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_BoxIterator.H>
+#include <AMReX_Config.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_FabArrayBase.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_LayoutData.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_REAL.H>
+#include <AMReX_RealVect.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Vector.H>
+#include <AMReX_iMultiFab.H>
+
+#if defined(AMREX_USE_MPI)
+#   include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+/**
+ * \brief Micro-benchmarks of the particle and field kernels of WarpX.
+ *
+ * The particle kernels (current and charge deposition, field gather and momentum
+ * pushers) are run on a single synthetic tile of tile_size cells along each
+ * direction, filled with ppc particles per cell at random positions and with a
+ * thermal momentum distribution. The field kernels (FDTD push, bilinear filter
+ * and PSATD push) are run on a single box of ncells cells along each direction,
+ * iterated with tiles of tile_size cells. The random numbers do not depend on
+ * the standard library or on the device, so that every build benchmarks exactly
+ * the same distributions.
+ *
+ * All parameters are optional and read from the command line or from an input
+ * file, with the prefix bench (see the documentation of WarpX_KERNEL_BENCH).
+ */
+namespace KernelBench
+{
+    using ParticleType = WarpXParticleContainer::ParticleType;
+
+    /** Parameters of the benchmarks */
+    struct Options
+    {
+        amrex::Vector<int> ppc = {1, 8, 32};
+        amrex::Vector<int> shape_order = {1, 2, 3};
+        amrex::Vector<int> tile_size = {8, 16, 32};
+        amrex::Vector<std::string> kernels;
+        int ncells = (AMREX_SPACEDIM == 3) ? 64 : 512;
+        int nrepeat = 10;
+        int psatd_order = 16;
+        int shuffle = 0;
+        amrex::Real u_th = 0.01;
+        std::uint64_t seed = 1;
+        std::string output;
+
+        bool run (std::string const& kernel) const
+        {
+            return kernels.empty() ||
+                std::find(kernels.begin(), kernels.end(), kernel) != kernels.end();
+        }
+    };
+
+    /** Timing of one kernel, for one configuration */
+    struct Result
+    {
+        std::string kernel;
+        // configuration (0 when the kernel does not depend on it)
+        int ppc = 0;
+        int shape_order = 0;
+        int tile_size = 0;
+        // number of particles or cells processed by each call
+        long n_items = 0;
+        // wall time per call (s), maximum over the MPI ranks
+        double time = 0.;
+    };
+
+    /** Reproducible random number generator (splitmix64) */
+    class Random
+    {
+    public:
+        explicit Random (std::uint64_t seed) : m_state(seed) {}
+
+        std::uint64_t next ()
+        {
+            std::uint64_t z = (m_state += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+
+        /** Uniform number in [0, 1) */
+        double uniform () { return (next() >> 11) * (1. / 9007199254740992.); }
+
+        /** Normal distribution (Box-Muller) */
+        double gaussian ()
+        {
+            const double u1 = 1. - uniform();
+            const double u2 = uniform();
+            return std::sqrt(-2.*std::log(u1)) * std::cos(2.*MathConst::pi*u2);
+        }
+
+    private:
+        std::uint64_t m_state;
+    };
+
+    /** Average wall time of nrepeat calls of f, after one warm-up call */
+    template <typename F>
+    double timeKernel (int nrepeat, F const& f)
+    {
+        f();
+        amrex::Gpu::synchronize();
+        const double t0 = amrex::second();
+        for (int i = 0; i < nrepeat; ++i) f();
+        amrex::Gpu::synchronize();
+        auto t = static_cast<amrex::Real>((amrex::second() - t0)/nrepeat);
+        amrex::ParallelDescriptor::ReduceRealMax(t);
+        return static_cast<double>(t);
+    }
+
+    /** Call f with the shape order as a compile-time constant */
+    template <typename F>
+    void dispatchShapeOrder (int order, F const& f)
+    {
+        if (order == 1) {
+            f(std::integral_constant<int, 1>{});
+        } else if (order == 2) {
+            f(std::integral_constant<int, 2>{});
+        } else if (order == 3) {
+            f(std::integral_constant<int, 3>{});
+        } else {
+            amrex::Abort("bench.shape_order must be 1, 2 or 3");
+        }
+    }
+
+    /** Index type of the component dir of E (electric) or B on the Yee grid */
+    amrex::IntVect yeeStaggering (bool electric, int dir)
+    {
+        const int n = electric ? 1 : 0;
+        amrex::IntVect flag(AMREX_D_DECL(n, n, n));
+#if defined(WARPX_DIM_3D)
+        flag[dir] = 1 - n;
+#else
+        if (dir != 1) flag[dir/2] = 1 - n;
+#endif
+        return flag;
+    }
+
+    /** Synthetic tile of particles, with the fields gathered and deposited by the particles */
+    struct ParticleTile
+    {
+        ParticleTile (int tile_size, int ppc, int ng, amrex::Real dx,
+                      Options const& opt)
+        {
+            using namespace amrex::literals;
+
+            const amrex::Box tilebox(amrex::IntVect(0), amrex::IntVect(tile_size-1));
+            box = amrex::grow(tilebox, ng);
+            lo = amrex::lbound(box);
+            cell_size = {dx, dx, dx};
+#if defined(WARPX_DIM_3D)
+            xyzmin = {-ng*dx, -ng*dx, -ng*dx};
+#else
+            xyzmin = {-ng*dx, std::numeric_limits<amrex::Real>::lowest(), -ng*dx};
+#endif
+            np = tilebox.numPts()*ppc;
+
+            // ppc particles in each cell, at random positions within the cell
+            Random random(opt.seed);
+            amrex::Vector<ParticleType> h_structs(np);
+            amrex::Vector<amrex::ParticleReal> h_ux(np), h_uy(np), h_uz(np);
+            const amrex::Real u_th = opt.u_th*PhysConst::c;
+            long ip = 0;
+            for (amrex::BoxIterator bi(tilebox); bi.ok(); ++bi) {
+                const amrex::IntVect iv = bi();
+                for (int n = 0; n < ppc; ++n, ++ip) {
+                    ParticleType& p = h_structs[ip];
+                    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+                        p.pos(d) = static_cast<amrex::ParticleReal>((iv[d] + random.uniform())*dx);
+                    }
+                    p.id() = ip + 1;
+                    p.cpu() = 0;
+                    h_ux[ip] = static_cast<amrex::ParticleReal>(u_th*random.gaussian());
+                    h_uy[ip] = static_cast<amrex::ParticleReal>(u_th*random.gaussian());
+                    h_uz[ip] = static_cast<amrex::ParticleReal>(u_th*random.gaussian());
+                }
+            }
+            if (opt.shuffle) {
+                for (long i = np - 1; i > 0; --i) {
+                    const auto j = static_cast<long>(random.next() % static_cast<std::uint64_t>(i + 1));
+                    std::swap(h_structs[i], h_structs[j]);
+                    std::swap(h_ux[i], h_ux[j]);
+                    std::swap(h_uy[i], h_uy[j]);
+                    std::swap(h_uz[i], h_uz[j]);
+                }
+            }
+
+            structs.resize(np);
+            ux.resize(np);
+            uy.resize(np);
+            uz.resize(np);
+            amrex::Gpu::copy(amrex::Gpu::hostToDevice, h_structs.begin(), h_structs.end(), structs.begin());
+            amrex::Gpu::copy(amrex::Gpu::hostToDevice, h_ux.begin(), h_ux.end(), ux.begin());
+            amrex::Gpu::copy(amrex::Gpu::hostToDevice, h_uy.begin(), h_uy.end(), uy.begin());
+            amrex::Gpu::copy(amrex::Gpu::hostToDevice, h_uz.begin(), h_uz.end(), uz.begin());
+
+            w.resize(np, 1.e10_prt);
+            Exp.resize(np, 1.e9_prt);
+            Eyp.resize(np, 0._prt);
+            Ezp.resize(np, 1.e9_prt);
+            Bxp.resize(np, 0._prt);
+            Byp.resize(np, 1._prt);
+            Bzp.resize(np, 0._prt);
+
+            for (int dir = 0; dir < 3; ++dir) {
+                e[dir].resize(amrex::convert(box, yeeStaggering(true, dir)), 1);
+                b[dir].resize(amrex::convert(box, yeeStaggering(false, dir)), 1);
+                j[dir].resize(amrex::convert(box, yeeStaggering(true, dir)), 1);
+                e[dir].setVal<amrex::RunOn::Device>(1.e9_rt);
+                b[dir].setVal<amrex::RunOn::Device>(1._rt);
+                j[dir].setVal<amrex::RunOn::Device>(0._rt);
+            }
+            rho.resize(amrex::convert(box, amrex::IntVect::TheNodeVector()), 1);
+            rho.setVal<amrex::RunOn::Device>(0._rt);
+            amrex::Gpu::synchronize();
+        }
+
+        GetParticlePosition getPosition () const
+        {
+            GetParticlePosition get_position;
+            get_position.m_structs = structs.dataPtr();
+            return get_position;
+        }
+
+        amrex::Box box;
+        amrex::Dim3 lo;
+        std::array<amrex::Real, 3> cell_size;
+        std::array<amrex::Real, 3> xyzmin;
+        long np;
+
+        amrex::Gpu::DeviceVector<ParticleType> structs;
+        amrex::Gpu::DeviceVector<amrex::ParticleReal> w, ux, uy, uz;
+        amrex::Gpu::DeviceVector<amrex::ParticleReal> Exp, Eyp, Ezp, Bxp, Byp, Bzp;
+        std::array<amrex::FArrayBox, 3> e, b, j;
+        amrex::FArrayBox rho;
+    };
+
+    /** Advance the momenta of the particles of tile with the pusher named name */
+    void pushMomentum (std::string const& name, ParticleTile& tile, amrex::Real dt)
+    {
+        const amrex::Real q = -PhysConst::q_e;
+        const amrex::Real m = PhysConst::m_e;
+        amrex::ParticleReal* const AMREX_RESTRICT ux = tile.ux.dataPtr();
+        amrex::ParticleReal* const AMREX_RESTRICT uy = tile.uy.dataPtr();
+        amrex::ParticleReal* const AMREX_RESTRICT uz = tile.uz.dataPtr();
+        const amrex::ParticleReal* const AMREX_RESTRICT Ex = tile.Exp.dataPtr();
+        const amrex::ParticleReal* const AMREX_RESTRICT Ey = tile.Eyp.dataPtr();
+        const amrex::ParticleReal* const AMREX_RESTRICT Ez = tile.Ezp.dataPtr();
+        const amrex::ParticleReal* const AMREX_RESTRICT Bx = tile.Bxp.dataPtr();
+        const amrex::ParticleReal* const AMREX_RESTRICT By = tile.Byp.dataPtr();
+        const amrex::ParticleReal* const AMREX_RESTRICT Bz = tile.Bzp.dataPtr();
+
+        if (name == "boris") {
+            amrex::ParallelFor(tile.np, [=] AMREX_GPU_DEVICE (long ip) {
+                UpdateMomentumBoris(ux[ip], uy[ip], uz[ip], Ex[ip], Ey[ip], Ez[ip],
+                                    Bx[ip], By[ip], Bz[ip], q, m, dt);
+            });
+        } else if (name == "vay") {
+            amrex::ParallelFor(tile.np, [=] AMREX_GPU_DEVICE (long ip) {
+                UpdateMomentumVay(ux[ip], uy[ip], uz[ip], Ex[ip], Ey[ip], Ez[ip],
+                                  Bx[ip], By[ip], Bz[ip], q, m, dt);
+            });
+        } else if (name == "higuera_cary") {
+            amrex::ParallelFor(tile.np, [=] AMREX_GPU_DEVICE (long ip) {
+                UpdateMomentumHigueraCary(ux[ip], uy[ip], uz[ip], Ex[ip], Ey[ip], Ez[ip],
+                                          Bx[ip], By[ip], Bz[ip], q, m, dt);
+            });
+        } else if (name == "boris_rr") {
+            amrex::ParallelFor(tile.np, [=] AMREX_GPU_DEVICE (long ip) {
+                UpdateMomentumBorisWithRadiationReaction(ux[ip], uy[ip], uz[ip],
+                                                         Ex[ip], Ey[ip], Ez[ip],
+                                                         Bx[ip], By[ip], Bz[ip], q, m, dt);
+            });
+        }
+    }
+
+    /** Benchmark the particle kernels on a tile of tile_size cells with ppc particles per cell */
+    void benchParticleKernels (Options const& opt, int ppc, int tile_size,
+                               amrex::Vector<Result>& results)
+    {
+        using namespace amrex::literals;
+
+        const amrex::Real dx = 1.e-6_rt;
+        const amrex::Real dt = 0.5_rt*dx/(std::sqrt(static_cast<amrex::Real>(AMREX_SPACEDIM))*PhysConst::c);
+        const amrex::Real q = -PhysConst::q_e;
+        const int max_order = *std::max_element(opt.shape_order.begin(), opt.shape_order.end());
+        ParticleTile tile(tile_size, ppc, max_order + 2, dx, opt);
+        const GetParticlePosition get_position = tile.getPosition();
+
+        auto add_result = [&] (std::string const& kernel, int order, double time) {
+            Result r;
+            r.kernel = kernel;
+            r.ppc = ppc;
+            r.shape_order = order;
+            r.tile_size = tile_size;
+            r.n_items = tile.np;
+            r.time = time;
+            results.push_back(r);
+        };
+
+        for (int const order : opt.shape_order)
+        {
+            if (opt.run("deposition")) {
+                const double t = timeKernel(opt.nrepeat, [&] () {
+                    dispatchShapeOrder(order, [&] (auto o) {
+                        doDepositionShapeN<decltype(o)::value>(
+                            get_position, tile.w.dataPtr(), tile.ux.dataPtr(),
+                            tile.uy.dataPtr(), tile.uz.dataPtr(), nullptr,
+                            tile.j[0], tile.j[1], tile.j[2], tile.np, -0.5_rt*dt,
+                            tile.cell_size, tile.xyzmin, tile.lo, q, 1, nullptr,
+                            WarpX::load_balance_costs_update_algo);
+                    });
+                });
+                add_result("deposition", order, t);
+            }
+
+            if (opt.run("esirkepov")) {
+                const amrex::Array4<amrex::Real> jx_arr = tile.j[0].array();
+                const amrex::Array4<amrex::Real> jy_arr = tile.j[1].array();
+                const amrex::Array4<amrex::Real> jz_arr = tile.j[2].array();
+                const double t = timeKernel(opt.nrepeat, [&] () {
+                    dispatchShapeOrder(order, [&] (auto o) {
+                        doEsirkepovDepositionShapeN<decltype(o)::value>(
+                            get_position, tile.w.dataPtr(), tile.ux.dataPtr(),
+                            tile.uy.dataPtr(), tile.uz.dataPtr(), nullptr,
+                            jx_arr, jy_arr, jz_arr, tile.np, dt,
+                            tile.cell_size, tile.xyzmin, tile.lo, q, 1, nullptr,
+                            WarpX::load_balance_costs_update_algo);
+                    });
+                });
+                add_result("esirkepov", order, t);
+            }
+
+            if (opt.run("charge")) {
+                const double t = timeKernel(opt.nrepeat, [&] () {
+                    dispatchShapeOrder(order, [&] (auto o) {
+                        doChargeDepositionShapeN<decltype(o)::value>(
+                            get_position, tile.w.dataPtr(), nullptr, tile.rho, tile.np,
+                            tile.cell_size, tile.xyzmin, tile.lo, q, 1, nullptr,
+                            WarpX::load_balance_costs_update_algo);
+                    });
+                });
+                add_result("charge", order, t);
+            }
+
+            if (opt.run("gather")) {
+                GetExternalEField get_external_E;
+                GetExternalBField get_external_B;
+                get_external_E.m_type = ExternalFieldInitType::Constant;
+                get_external_B.m_type = ExternalFieldInitType::Constant;
+                get_external_E.m_field_value = {0._prt, 0._prt, 0._prt};
+                get_external_B.m_field_value = {0._prt, 0._prt, 0._prt};
+                const double t = timeKernel(opt.nrepeat, [&] () {
+                    dispatchShapeOrder(order, [&] (auto o) {
+                        doGatherShapeN<decltype(o)::value, 1>(
+                            get_position, get_external_E, get_external_B,
+                            tile.Exp.dataPtr(), tile.Eyp.dataPtr(), tile.Ezp.dataPtr(),
+                            tile.Bxp.dataPtr(), tile.Byp.dataPtr(), tile.Bzp.dataPtr(),
+                            &tile.e[0], &tile.e[1], &tile.e[2],
+                            &tile.b[0], &tile.b[1], &tile.b[2],
+                            tile.np, tile.cell_size, tile.xyzmin, tile.lo, 1);
+                    });
+                });
+                add_result("gather", order, t);
+            }
+        }
+
+        // The pushers do not depend on the shape order
+        for (std::string const pusher : {"boris", "vay", "higuera_cary", "boris_rr"})
+        {
+            if (!opt.run(pusher)) continue;
+            const double t = timeKernel(opt.nrepeat, [&] () { pushMomentum(pusher, tile, dt); });
+            add_result(pusher, 0, t);
+        }
+    }
+
+    /** Benchmark the field kernels on a box of opt.ncells cells, with tiles of tile_size cells */
+    void benchFieldKernels (Options const& opt, int tile_size, amrex::Vector<Result>& results)
+    {
+        using namespace amrex::literals;
+
+        if (!opt.run("evolve_b") && !opt.run("evolve_e") && !opt.run("filter")) return;
+
+        const amrex::IntVect tile_size_default = amrex::FabArrayBase::mfiter_tile_size;
+        amrex::FabArrayBase::mfiter_tile_size = amrex::IntVect(AMREX_D_DECL(tile_size, tile_size, tile_size));
+
+        const amrex::Real dx = 1.e-6_rt;
+        const amrex::Box domain(amrex::IntVect(0), amrex::IntVect(opt.ncells-1));
+        const amrex::BoxArray ba(domain);
+        const amrex::DistributionMapping dm(ba);
+        const int ng = 2;
+
+        std::array<std::unique_ptr<amrex::MultiFab>, 3> E, B, J;
+        for (int dir = 0; dir < 3; ++dir) {
+            E[dir] = std::make_unique<amrex::MultiFab>(
+                amrex::convert(ba, yeeStaggering(true, dir)), dm, 1, ng);
+            B[dir] = std::make_unique<amrex::MultiFab>(
+                amrex::convert(ba, yeeStaggering(false, dir)), dm, 1, ng);
+            J[dir] = std::make_unique<amrex::MultiFab>(
+                amrex::convert(ba, yeeStaggering(true, dir)), dm, 1, ng);
+            E[dir]->setVal(1.e9_rt);
+            B[dir]->setVal(1._rt);
+            J[dir]->setVal(1.e12_rt);
+        }
+        const long n_cells = domain.numPts();
+
+        auto add_result = [&] (std::string const& kernel, double time) {
+            Result r;
+            r.kernel = kernel;
+            r.tile_size = tile_size;
+            r.n_items = n_cells;
+            r.time = time;
+            results.push_back(r);
+        };
+
+        std::array<amrex::Real, 3> cell_size = {dx, dx, dx};
+        FiniteDifferenceSolver solver(MaxwellSolverAlgo::Yee, cell_size, false);
+        const amrex::Real dt = 0.5_rt*CartesianYeeAlgorithm::ComputeMaxDt(cell_size.data());
+        std::array<std::unique_ptr<amrex::MultiFab>, 3> no_fields;
+        std::unique_ptr<amrex::MultiFab> no_field;
+        std::array<std::unique_ptr<amrex::iMultiFab>, 3> no_flags;
+        std::array<std::unique_ptr<amrex::LayoutData<FaceInfoBox>>, 3> no_borrowing;
+
+        if (opt.run("evolve_b")) {
+            add_result("evolve_b", timeKernel(opt.nrepeat, [&] () {
+                solver.EvolveB(B, E, no_field, no_fields, no_fields, no_fields, no_fields,
+                               no_flags, no_borrowing, 0, dt);
+            }));
+        }
+        if (opt.run("evolve_e")) {
+            add_result("evolve_e", timeKernel(opt.nrepeat, [&] () {
+                solver.EvolveE(E, B, J, no_fields, no_fields, no_fields, no_field, 0, dt);
+            }));
+        }
+        if (opt.run("filter")) {
+            BilinearFilter filter;
+            for (auto& npass : filter.npass_each_dir) npass = 1u;
+            filter.ComputeStencils();
+            amrex::MultiFab Jf(J[0]->boxArray(), dm, 1, ng);
+            add_result("filter", timeKernel(opt.nrepeat, [&] () {
+                filter.ApplyStencil(Jf, *J[0], 0);
+            }));
+        }
+
+        amrex::FabArrayBase::mfiter_tile_size = tile_size_default;
+    }
+
+    /** Benchmark the PSATD push and the associated FFTs on a box of opt.ncells cells */
+    void benchPsatd (Options const& opt, amrex::Vector<Result>& results)
+    {
+#ifdef WARPX_USE_PSATD
+        using namespace amrex::literals;
+
+        if (!opt.run("psatd")) return;
+
+        const amrex::Real dx = 1.e-6_rt;
+        const amrex::Box domain(amrex::IntVect(0), amrex::IntVect(opt.ncells-1));
+        const amrex::BoxArray ba(domain);
+        const amrex::DistributionMapping dm(ba);
+        const int ng = opt.psatd_order/2;
+
+        // as in WarpX::AllocLevelSpectralSolver: cell-centered, including guard cells
+        amrex::BoxArray realspace_ba = ba;
+        realspace_ba.grow(ng);
+        const amrex::RealVect dx_vect(AMREX_D_DECL(dx, dx, dx));
+        const amrex::Real dt = dx/PhysConst::c;
+        SpectralSolver solver(0, realspace_ba, dm, opt.psatd_order, opt.psatd_order,
+                              opt.psatd_order, false, amrex::IntVect(0),
+                              {0._rt, 0._rt, 0._rt}, {0._rt, 0._rt, 0._rt}, dx_vect, dt,
+                              false, false, false, false, false, false, false);
+        const SpectralFieldIndex& Idx = solver.m_spectral_index;
+
+        std::array<std::unique_ptr<amrex::MultiFab>, 3> E, B, J;
+        for (int dir = 0; dir < 3; ++dir) {
+            E[dir] = std::make_unique<amrex::MultiFab>(
+                amrex::convert(ba, yeeStaggering(true, dir)), dm, 1, ng);
+            B[dir] = std::make_unique<amrex::MultiFab>(
+                amrex::convert(ba, yeeStaggering(false, dir)), dm, 1, ng);
+            J[dir] = std::make_unique<amrex::MultiFab>(
+                amrex::convert(ba, yeeStaggering(true, dir)), dm, 1, ng);
+            E[dir]->setVal(1.e9_rt);
+            B[dir]->setVal(1._rt);
+            J[dir]->setVal(1.e12_rt);
+        }
+        const int E_idx[3] = {Idx.Ex, Idx.Ey, Idx.Ez};
+        const int B_idx[3] = {Idx.Bx, Idx.By, Idx.Bz};
+        const int J_idx[3] = {Idx.Jx, Idx.Jy, Idx.Jz};
+
+        auto add_result = [&] (std::string const& kernel, double time) {
+            Result r;
+            r.kernel = kernel;
+            r.n_items = domain.numPts();
+            r.time = time;
+            results.push_back(r);
+        };
+
+        // forward FFTs of E, B, J and backward FFTs of E, B, as in WarpX::PushPSATD
+        add_result("psatd_fft", timeKernel(opt.nrepeat, [&] () {
+            for (int dir = 0; dir < 3; ++dir) {
+                solver.ForwardTransform(0, *E[dir], E_idx[dir]);
+                solver.ForwardTransform(0, *B[dir], B_idx[dir]);
+                solver.ForwardTransform(0, *J[dir], J_idx[dir]);
+            }
+            for (int dir = 0; dir < 3; ++dir) {
+                solver.BackwardTransform(0, *E[dir], E_idx[dir]);
+                solver.BackwardTransform(0, *B[dir], B_idx[dir]);
+            }
+        }));
+        add_result("psatd_push", timeKernel(opt.nrepeat, [&] () {
+            solver.pushSpectralFields();
+        }));
+#else
+        amrex::ignore_unused(opt, results);
+#endif
+    }
+
+    /** Print the results, and write them to opt.output in CSV format if it is set */
+    void writeResults (Options const& opt, amrex::Vector<Result> const& results)
+    {
+        auto column = [] (int v) { return v > 0 ? std::to_string(v) : std::string("-"); };
+
+        amrex::Print() << "\n"
+                       << std::setw(14) << std::left << "kernel"
+                       << std::setw(6) << std::right << "ppc"
+                       << std::setw(7) << "order"
+                       << std::setw(6) << "tile"
+                       << std::setw(12) << "items"
+                       << std::setw(14) << "time/call(s)"
+                       << std::setw(12) << "ns/item" << "\n";
+        for (auto const& r : results) {
+            amrex::Print() << std::setw(14) << std::left << r.kernel
+                           << std::setw(6) << std::right << column(r.ppc)
+                           << std::setw(7) << column(r.shape_order)
+                           << std::setw(6) << column(r.tile_size)
+                           << std::setw(12) << r.n_items
+                           << std::setw(14) << std::scientific << std::setprecision(4) << r.time
+                           << std::setw(12) << std::fixed << std::setprecision(3)
+                           << 1.e9*r.time/static_cast<double>(std::max(r.n_items, 1l))
+                           << std::defaultfloat << "\n";
+        }
+
+        if (opt.output.empty() || !amrex::ParallelDescriptor::IOProcessor()) return;
+        std::ofstream ofs(opt.output, std::ofstream::out);
+        ofs << "kernel,ppc,shape_order,tile_size,items,time_per_call,ns_per_item\n";
+        ofs << std::setprecision(8);
+        for (auto const& r : results) {
+            ofs << r.kernel << "," << r.ppc << "," << r.shape_order << "," << r.tile_size << ","
+                << r.n_items << "," << r.time << ","
+                << 1.e9*r.time/static_cast<double>(std::max(r.n_items, 1l)) << "\n";
+        }
+    }
+
+    Options readOptions ()
+    {
+        Options opt;
+        amrex::ParmParse pp_bench("bench");
+        pp_bench.queryarr("ppc", opt.ppc);
+        pp_bench.queryarr("shape_order", opt.shape_order);
+        pp_bench.queryarr("tile_size", opt.tile_size);
+        pp_bench.queryarr("kernels", opt.kernels);
+        pp_bench.query("ncells", opt.ncells);
+        pp_bench.query("nrepeat", opt.nrepeat);
+        pp_bench.query("psatd_order", opt.psatd_order);
+        pp_bench.query("shuffle", opt.shuffle);
+        pp_bench.query("u_th", opt.u_th);
+        long seed = static_cast<long>(opt.seed);
+        pp_bench.query("seed", seed);
+        opt.seed = static_cast<std::uint64_t>(seed);
+        pp_bench.query("output", opt.output);
+
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!opt.ppc.empty() && !opt.shape_order.empty() &&
+                                         !opt.tile_size.empty(),
+                                         "bench.ppc, bench.shape_order and bench.tile_size must not be empty");
+        for (int const order : opt.shape_order) {
+            AMREX_ALWAYS_ASSERT_WITH_MESSAGE(order >= 1 && order <= 3,
+                                             "bench.shape_order must be 1, 2 or 3");
+        }
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(opt.nrepeat >= 1, "bench.nrepeat must be positive");
+        return opt;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    using namespace KernelBench;
+
+    auto mpi_thread_levels = utils::warpx_mpi_init(argc, argv);
+
+    warpx_amrex_init(argc, argv);
+
+    utils::warpx_check_mpi_thread_level(mpi_thread_levels);
+
+    {
+        const Options opt = readOptions();
+        amrex::Vector<Result> results;
+
+        for (int const tile_size : opt.tile_size) {
+            for (int const ppc : opt.ppc) {
+                benchParticleKernels(opt, ppc, tile_size, results);
+            }
+            benchFieldKernels(opt, tile_size, results);
+        }
+        benchPsatd(opt, results);
+
+        writeResults(opt, results);
+    }
+
+    amrex::Finalize();
+#if defined(AMREX_USE_MPI)
+    MPI_Finalize();
+#endif
+}
@@ -159,7 +159,11 @@ function(set_warpx_binary_name)
         list(APPEND warpx_bin_names shared)
     endif()
     foreach(tgt IN LISTS _ALL_TARGETS)
-        set_target_properties(${tgt} PROPERTIES OUTPUT_NAME "warpx")
+        if(tgt STREQUAL warpx_kernel_bench)
+            set_target_properties(${tgt} PROPERTIES OUTPUT_NAME "warpx_kernel_bench")
+        else()
+            set_target_properties(${tgt} PROPERTIES OUTPUT_NAME "warpx")
+        endif()
         if(WarpX_DIMS STREQUAL 3)
             set_property(TARGET ${tgt} APPEND_STRING PROPERTY OUTPUT_NAME ".3d")
         elseif(WarpX_DIMS STREQUAL 2)
@@ -343,6 +347,7 @@ function(warpx_print_summary)
     message("    Embedded Boundary: ${WarpX_EB}")
     message("    GPU clock timers: ${WarpX_GPUCLOCK}")
     message("    IPO/LTO: ${WarpX_IPO}")
+    message("    Kernel benchmarks: ${WarpX_KERNEL_BENCH}")
     message("    LIB: ${WarpX_LIB}${LIB_TYPE}")
     message("    MPI: ${WarpX_MPI}")
     if(MPI)
@@ -351,6 +356,7 @@ function(warpx_print_summary)
     message("    PSATD: ${WarpX_PSATD}")
     message("    PRECISION: ${WarpX_PRECISION}")
     message("    OPENPMD: ${WarpX_OPENPMD}")
+    message("    PARSER JIT: ${WarpX_PARSER_JIT}")
     message("    QED: ${WarpX_QED}")
     message("    QED table generation: ${WarpX_QED_TABLE_GEN}")
     message("    SENSEI: ${WarpX_SENSEI}")